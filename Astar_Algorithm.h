@@ -2,6 +2,7 @@
 #define ASTAR_ALGORITHM_H
 
 #include "Graph.h"
+#include "Priority_Queues.h"
 #include <vector>
 #include <unordered_map>
 #include <queue>
@@ -41,8 +42,9 @@ double heuristic(const Graph& graph, int current, int target) {
     return max(0.0, h); // heuristic must be non-negative
 }
 
-// A* search
-vector<int> astar(const Graph& graph, int start, int target) {
+// A* search, generic over the open-set queue (see Priority_Queues.h)
+template <typename Queue>
+vector<int> astarWithQueue(const Graph& graph, int start, int target, Queue& pq) {
     
     unordered_map<int, double> g; //old distance
     unordered_map<int, double> f; // new distance
@@ -58,13 +60,10 @@ vector<int> astar(const Graph& graph, int start, int target) {
     g[start] = 0.0;
     f[start] = g[start] + heuristic(graph, start, target);
 
-    priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
-    
-    pq.push({f[start], start});
+    pq.push(start, f[start]);
 
     while (!pq.empty()) {
-        int current = pq.top().second;
-        pq.pop();
+        int current = pq.pop();
 
         if (visited[current]) continue;
 
@@ -100,7 +99,7 @@ vector<int> astar(const Graph& graph, int start, int target) {
                 prev[v] = current;
                 g[v] = g[current] + cost;
                 f[v] = g[v] + heuristic(graph, v, target);
-                pq.push({f[v], v});
+                pq.push(v, f[v]);
             }
         }
     }
@@ -108,6 +107,29 @@ vector<int> astar(const Graph& graph, int start, int target) {
     return {}; // no path found
 }
 
+// A* search with a selectable queue, binary heap by default
+vector<int> astar(const Graph& graph, int start, int target, QueueType queueType = QueueType::BINARY_HEAP) {
+
+    switch (queueType) {
+        case QueueType::RADIX_HEAP: {
+            RadixHeapQueue pq;
+            return astarWithQueue(graph, start, target, pq);
+        }
+        case QueueType::DIAL_BUCKETS: {
+            DialQueue pq;
+            return astarWithQueue(graph, start, target, pq);
+        }
+        case QueueType::QUAD_HEAP: {
+            QuadHeapQueue pq;
+            return astarWithQueue(graph, start, target, pq);
+        }
+        default: {
+            BinaryHeapQueue pq;
+            return astarWithQueue(graph, start, target, pq);
+        }
+    }
+}
+
 
 
 #endif
@@ -0,0 +1,75 @@
+#ifndef BINARY_READER_H
+#define BINARY_READER_H
+
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+
+// Reads a whole binary file (scenario, results, hierarchy) into memory and
+// hands it out field by field. Every read is bounds checked, and counts
+// from a header are checked against the bytes left before anything is sized
+// by them, so a damaged file throws instead of allocating gigabytes.
+// Errors read "<problem> <kind> file: <filename>".
+
+class BinaryReader {
+private:
+    string filename;
+    string kind;
+    string content;
+    size_t offset = 0;
+
+public:
+    BinaryReader(const string& filename, const string& kind) : filename(filename), kind(kind) {
+        ifstream file(filename, ios::binary);
+
+        if (!file.is_open()) {
+            throw runtime_error("Cannot open file: " + filename);
+        }
+
+        content.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    }
+
+    runtime_error error(const string& problem) const {
+        return runtime_error(problem + " " + kind + " file: " + filename);
+    }
+
+    void read(void* dst, size_t size) {
+        if (size > remaining()) throw error("Truncated");
+        if (size > 0) memcpy(dst, content.data() + offset, size);
+        offset += size;
+    }
+
+    template <typename T>
+    T get() {
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    // throws unless count records of recordSize bytes can still follow
+    void expect(uint64_t count, size_t recordSize) const {
+        if (recordSize > 0 && count > remaining() / recordSize) throw error("Truncated");
+    }
+
+    // checks the 4 byte magic and a version in [minVersion, maxVersion]; returns the version
+    uint32_t header(const char* magic, uint32_t minVersion, uint32_t maxVersion) {
+        char found[4];
+        read(found, sizeof(found));
+        uint32_t version = get<uint32_t>();
+
+        if (memcmp(found, magic, 4) != 0 || version < minVersion || version > maxVersion) {
+            throw runtime_error("Not a " + kind + " file: " + filename);
+        }
+        return version;
+    }
+
+    size_t remaining() const { return content.size() - offset; }
+    bool done() const { return offset >= content.size(); }
+};
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef CLUSTER_ALLOCATION_H
+#define CLUSTER_ALLOCATION_H
+
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Greedy_Allocation.h"
+#include "Two_Opt_Algorithm.h"
+#include "Contraction_Hierarchy.h"
+#include "Dense_Graph.h"
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <exception>
+#include <iostream>
+
+using namespace std;
+
+// Cluster-first, route-second allocation.
+//
+// Customers are split into one capacity-balanced cluster per group of
+// vehicles (vehiclesPerCluster, default 1), then every cluster is routed on
+// its own by the usual greedy assignment plus twoOpt, in parallel. The work
+// per customer only depends on the vehicles of its own cluster, so the total
+// cost grows roughly linearly with the fleet instead of N x V.
+//
+// The graph has no coordinates, so both clustering methods work on
+// shortest-path distances:
+//   SWEEP      walks the depot's shortest-path tree depth first and cuts the
+//              resulting order into consecutive clusters by capacity
+//   K_MEDOIDS  starts from the sweep clusters and alternates between moving
+//              each medoid to the center of its cluster and reassigning
+//              customers to the nearest medoid that still has room
+
+enum class ClusterMethod {
+    SWEEP,
+    K_MEDOIDS
+};
+
+struct ClusterOptions {
+    ClusterMethod method = ClusterMethod::SWEEP;
+    int vehiclesPerCluster = 1;
+    int medoidIterations = 5;
+    int threads = 0;              // 0 = hardware concurrency
+};
+
+// Dijkstra state for clustering, one per clustering run. The DenseGraph is
+// read-only, so a long running caller can build it once and share it.
+class ClusterSearch {
+private:
+    const DenseGraph& dense;
+
+    vector<double> dist;
+    vector<int> label;
+    vector<int> touched;
+
+public:
+    explicit ClusterSearch(const DenseGraph& dense) : dense(dense), dist(dense.size(), INF), label(dense.size(), -1) {}
+
+    int size() const { return dense.size(); }
+    int idOf(int index) const { return dense.idOf(index); }
+    int indexOfNode(int id) const { return dense.indexOfNode(id); }
+
+    // Multi-source Dijkstra. sources are (index, label) pairs; afterwards
+    // distanceTo / labelOf give the distance to and label of the nearest
+    // source. The search stops early once remaining nodes have all been
+    // settled (when remaining > 0).
+    void multiSource(const vector<pair<int, int>>& sources, vector<int>* parent = nullptr, int remaining = 0, const vector<char>* wanted = nullptr) {
+        for (int v : touched) {
+            dist[v] = INF;
+            label[v] = -1;
+        }
+        touched.clear();
+
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+        for (const auto& source : sources) {
+            if (dist[source.first] == 0.0) continue;
+            dist[source.first] = 0.0;
+            label[source.first] = source.second;
+            touched.push_back(source.first);
+            pq.push({0.0, source.first});
+            if (parent) (*parent)[source.first] = -1;
+        }
+
+        while (!pq.empty()) {
+            auto [d, u] = pq.top();
+            pq.pop();
+
+            if (d > dist[u]) continue;
+            if (wanted && (*wanted)[u] && --remaining == 0) break;
+
+            for (int k = dense.offset[u]; k < dense.offset[u + 1]; k++) {
+                int v = dense.target[k];
+                double nd = d + dense.cost[k];
+                if (nd < dist[v]) {
+                    if (dist[v] == INF) touched.push_back(v);
+                    dist[v] = nd;
+                    label[v] = label[u];
+                    if (parent) (*parent)[v] = u;
+                    pq.push({nd, v});
+                }
+            }
+        }
+    }
+
+    double distanceTo(int v) const { return dist[v]; }
+    int labelOf(int v) const { return label[v]; }
+};
+
+// Customers the greedy pass would be able to fit at all: highest priority
+// first, skipping anyone whose demand no longer fits the total capacity.
+vector<int> servableCustomers(const Graph& graph, long long totalCapacity) {
+    vector<int> N = graph.getAllNodeIds();
+    N.erase(std::remove(N.begin(), N.end(), 0), N.end());
+
+    sort(N.begin(), N.end(), [&](int a, int b){
+            const Node* nodeA = graph.getNode(a);
+            const Node* nodeB = graph.getNode(b);
+            if (nodeA->priority != nodeB->priority) return nodeA->priority > nodeB->priority;
+            return a < b;
+    });
+
+    vector<int> servable;
+    long long used = 0;
+    for (int nodeId : N) {
+        int demand = graph.getNode(nodeId)->demand;
+        if (used + demand <= totalCapacity) {
+            servable.push_back(nodeId);
+            used += demand;
+        }
+    }
+    return servable;
+}
+
+// puts nodes into clusters first fit, leftovers that fit nowhere are dropped
+void firstFit(const Graph& graph, const vector<int>& nodes, const vector<long long>& capacity, vector<long long>& load, vector<vector<int>>& clusters) {
+    for (int nodeId : nodes) {
+        int demand = graph.getNode(nodeId)->demand;
+        for (int c = 0; c < (int)clusters.size(); c++) {
+            if (load[c] + demand <= capacity[c]) {
+                clusters[c].push_back(nodeId);
+                load[c] += demand;
+                break;
+            }
+        }
+    }
+}
+
+vector<vector<int>> sweepClusters(const Graph& graph, ClusterSearch& cg, const vector<int>& customers, const vector<long long>& capacity) {
+    int n = cg.size();
+    vector<vector<int>> clusters(capacity.size());
+    vector<long long> load(capacity.size(), 0);
+
+    int depot = cg.indexOfNode(0);
+    vector<char> isCustomer(n, 0);
+    for (int nodeId : customers) isCustomer[cg.indexOfNode(nodeId)] = 1;
+
+    vector<int> order;
+    if (depot >= 0) {
+        vector<int> parent(n, -1);
+        cg.multiSource({{depot, 0}}, &parent);
+
+        // children of each node in the shortest-path tree
+        vector<vector<int>> children(n);
+        for (int v = 0; v < n; v++) {
+            if (parent[v] >= 0) children[parent[v]].push_back(v);
+        }
+        for (auto& list : children) {
+            sort(list.begin(), list.end(), [&](int a, int b) {
+                return cg.distanceTo(a) < cg.distanceTo(b) || (cg.distanceTo(a) == cg.distanceTo(b) && a < b);
+            });
+        }
+
+        // depth first preorder keeps each branch of the tree together
+        vector<int> stack = {depot};
+        while (!stack.empty()) {
+            int v = stack.back();
+            stack.pop_back();
+            if (isCustomer[v]) order.push_back(cg.idOf(v));
+            for (int i = (int)children[v].size() - 1; i >= 0; i--) stack.push_back(children[v][i]);
+        }
+    }
+
+    vector<int> leftover;
+    int c = 0;
+    for (int nodeId : order) {
+        int demand = graph.getNode(nodeId)->demand;
+        while (c < (int)clusters.size() && load[c] + demand > capacity[c] && load[c] > 0) c++;
+
+        if (c < (int)clusters.size() && load[c] + demand <= capacity[c]) {
+            clusters[c].push_back(nodeId);
+            load[c] += demand;
+        } else {
+            leftover.push_back(nodeId);
+        }
+    }
+
+    firstFit(graph, leftover, capacity, load, clusters);
+    return clusters;
+}
+
+vector<vector<int>> medoidClusters(const Graph& graph, ClusterSearch& cg, const vector<int>& customers, const vector<long long>& capacity, int iterations) {
+    int k = capacity.size();
+    int n = cg.size();
+    vector<vector<int>> clusters = sweepClusters(graph, cg, customers, capacity);
+
+    // initial medoid: the middle of each sweep cluster
+    vector<int> medoid(k, -1);
+    for (int c = 0; c < k; c++) {
+        if (!clusters[c].empty()) medoid[c] = cg.indexOfNode(clusters[c][clusters[c].size() / 2]);
+    }
+
+    vector<char> member(n, 0);
+
+    for (int iter = 0; iter < iterations; iter++) {
+
+        // 1) move each medoid to the center of its cluster: the member that
+        //    best splits the cluster diameter found by a double sweep
+        bool moved = false;
+        for (int c = 0; c < k; c++) {
+            if (clusters[c].size() < 3) continue;
+
+            for (int nodeId : clusters[c]) member[cg.indexOfNode(nodeId)] = 1;
+            int size = clusters[c].size();
+
+            if (medoid[c] < 0) medoid[c] = cg.indexOfNode(clusters[c][0]);
+
+            auto farthestFrom = [&](int source) {
+                cg.multiSource({{source, c}}, nullptr, size, &member);
+                int best = source;
+                for (int nodeId : clusters[c]) {
+                    int v = cg.indexOfNode(nodeId);
+                    if (cg.distanceTo(v) != INF && cg.distanceTo(v) > cg.distanceTo(best)) best = v;
+                }
+                return best;
+            };
+
+            int a = farthestFrom(medoid[c]);
+            int b = farthestFrom(a);
+
+            vector<double> fromA(size);
+            for (int i = 0; i < size; i++) fromA[i] = cg.distanceTo(cg.indexOfNode(clusters[c][i]));
+
+            cg.multiSource({{b, c}}, nullptr, size, &member);
+
+            int center = medoid[c];
+            double bestSpread = INF;
+            for (int i = 0; i < size; i++) {
+                int v = cg.indexOfNode(clusters[c][i]);
+                double spread = max(fromA[i], cg.distanceTo(v));
+                if (spread < bestSpread) {
+                    bestSpread = spread;
+                    center = v;
+                }
+            }
+
+            for (int nodeId : clusters[c]) member[cg.indexOfNode(nodeId)] = 0;
+
+            if (center != medoid[c]) {
+                medoid[c] = center;
+                moved = true;
+            }
+        }
+
+        if (!moved && iter > 0) break;
+
+        // 2) capacity constrained assignment: closest customers claim their
+        //    nearest medoid first, the ones that do not fit are grown again
+        //    from clusters that still have room
+        vector<pair<int, int>> sources;
+        for (int c = 0; c < k; c++) {
+            if (medoid[c] >= 0) sources.push_back({medoid[c], c});
+        }
+        if (sources.empty()) break;
+
+        vector<vector<int>> next(k);
+        vector<long long> load(k, 0);
+        vector<int> pending = customers;
+
+        for (int round = 0; round < 4 && !pending.empty() && !sources.empty(); round++) {
+            cg.multiSource(sources);
+
+            sort(pending.begin(), pending.end(), [&](int x, int y) {
+                double dx = cg.distanceTo(cg.indexOfNode(x));
+                double dy = cg.distanceTo(cg.indexOfNode(y));
+                return dx < dy || (dx == dy && x < y);
+            });
+
+            vector<int> overflow;
+            for (int nodeId : pending) {
+                int v = cg.indexOfNode(nodeId);
+                int c = cg.labelOf(v);
+                int demand = graph.getNode(nodeId)->demand;
+                if (c >= 0 && load[c] + demand <= capacity[c]) {
+                    next[c].push_back(nodeId);
+                    load[c] += demand;
+                } else {
+                    overflow.push_back(nodeId);
+                }
+            }
+            pending.swap(overflow);
+
+            // the next round grows only from clusters with room left
+            sources.clear();
+            for (int c = 0; c < k; c++) {
+                if (load[c] >= capacity[c]) continue;
+                for (int nodeId : next[c]) sources.push_back({cg.indexOfNode(nodeId), c});
+                if (medoid[c] >= 0) sources.push_back({medoid[c], c});
+            }
+        }
+
+        firstFit(graph, pending, capacity, load, next);
+        clusters.swap(next);
+    }
+
+    return clusters;
+}
+
+// One customer list per group of vehiclesPerCluster consecutive vehicles.
+// dense must have been built from graph.
+vector<vector<int>> clusterCustomers(const Graph& graph, const DenseGraph& dense, const vector<Vehicle>& vehicles, const ClusterOptions& options) {
+    int perCluster = max(1, options.vehiclesPerCluster);
+    int k = ((int)vehicles.size() + perCluster - 1) / perCluster;
+
+    vector<long long> capacity(k, 0);
+    long long totalCapacity = 0;
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        capacity[i / perCluster] += vehicles[i].capacity - vehicles[i].currentLoad;
+        totalCapacity += vehicles[i].capacity - vehicles[i].currentLoad;
+    }
+
+    vector<int> customers = servableCustomers(graph, totalCapacity);
+    ClusterSearch cg(dense);
+
+    if (options.method == ClusterMethod::K_MEDOIDS) {
+        return medoidClusters(graph, cg, customers, capacity, options.medoidIterations);
+    }
+    return sweepClusters(graph, cg, customers, capacity);
+}
+
+vector<vector<int>> clusterCustomers(const Graph& graph, const vector<Vehicle>& vehicles, const ClusterOptions& options) {
+    return clusterCustomers(graph, DenseGraph(graph), vehicles, options);
+}
+
+// Cluster-first allocation. makeTravelCost() is called once per worker
+// thread and must return a travel cost callable as used by assignCustomers.
+// Routes come back already improved by twoOpt. dense is the DenseGraph
+// of graph kept by the caller across calls.
+template <typename MakeTravelCost>
+vector<Vehicle> allocateVehiclesClusteredWith(const Graph& graph, const DenseGraph& dense, const vector<Vehicle>& vehicles, const ClusterOptions& options, MakeTravelCost makeTravelCost, const string& queryName) {
+
+    vector<Vehicle> V = vehicles;
+    vector<vector<int>> clusters = clusterCustomers(graph, dense, vehicles, options);
+
+    int perCluster = max(1, options.vehiclesPerCluster);
+    int threads = options.threads > 0 ? options.threads : max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, (int)clusters.size()));
+
+    atomic<int> nextCluster(0);
+    mutex statsMutex;
+    double sumTime = 0; // nanoseconds
+    int number = 0;
+    exception_ptr failure;
+
+    auto work = [&]() {
+        auto travelCost = makeTravelCost();
+        double localTime = 0;
+        int localNumber = 0;
+
+        for (int c = nextCluster++; c < (int)clusters.size(); c = nextCluster++) {
+            int first = c * perCluster;
+            int last = min((int)V.size(), first + perCluster);
+
+            // each cluster owns a disjoint slice of V, so no locking needed
+            vector<Vehicle> group(V.begin() + first, V.begin() + last);
+            assignCustomers(graph, group, clusters[c], travelCost, localTime, localNumber);
+
+            for (auto& vehicle : group) {
+                vehicle.route.push_back(0);
+                vehicle.route = twoOpt(graph, vehicle.route);
+            }
+            copy(group.begin(), group.end(), V.begin() + first);
+        }
+
+        lock_guard<mutex> lock(statsMutex);
+        sumTime += localTime;
+        number += localNumber;
+    };
+
+    // an exception escaping a std::thread would terminate the process, so the
+    // first one is kept, the remaining clusters are abandoned and it is
+    // rethrown once every worker has stopped
+    auto worker = [&]() {
+        try {
+            work();
+        } catch (...) {
+            nextCluster = clusters.size();
+            lock_guard<mutex> lock(statsMutex);
+            if (!failure) failure = current_exception();
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    if (failure) rethrow_exception(failure);
+
+    if (number > 0) {
+        double avgTime = sumTime / number;
+        cout << "Average " << queryName << " runtime: " << avgTime << " ns" << endl;
+    }
+    return V;
+}
+
+template <typename MakeTravelCost>
+vector<Vehicle> allocateVehiclesClusteredWith(const Graph& graph, const vector<Vehicle>& vehicles, const ClusterOptions& options, MakeTravelCost makeTravelCost, const string& queryName) {
+    return allocateVehiclesClusteredWith(graph, DenseGraph(graph), vehicles, options, makeTravelCost, queryName);
+}
+
+vector<Vehicle> allocateVehiclesClustered(const Graph& graph, const vector<Vehicle>& vehicles, const ClusterOptions& options = ClusterOptions(), QueueType queueType = QueueType::BINARY_HEAP) {
+
+    return allocateVehiclesClusteredWith(graph, vehicles, options, [&]() {
+        return [&graph, queueType](int from, int to) {
+            return astarTravelCost(graph, from, to, queueType);
+        };
+    }, "A*");
+}
+
+vector<Vehicle> allocateVehiclesClustered(const Graph& graph, const vector<Vehicle>& vehicles, const ContractionHierarchy& ch, const ClusterOptions& options = ClusterOptions()) {
+
+    return allocateVehiclesClusteredWith(graph, vehicles, options, [&]() {
+        auto query = make_shared<CHQuery>(ch);
+        return [query](int from, int to) {
+            return query->distance(from, to);
+        };
+    }, "CH query");
+}
+
+#endif
@@ -0,0 +1,549 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Greedy_Allocation.h"
+#include "Binary_Reader.h"
+#include "Dense_Graph.h"
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <iostream>
+
+using namespace std;
+
+// Contraction hierarchies for exact point-to-point shortest paths.
+//
+// Preprocessing contracts nodes one by one (cheapest first by edge
+// difference), adding a shortcut u-w whenever the only shortest u-w path
+// runs through the contracted node. Every arc ends up stored at its
+// lower-ranked endpoint, so a query is two small Dijkstra searches that only
+// go upward, one from each end, meeting at the highest node of the path.
+// Shortcuts remember the node they bypass, which is enough to unpack a query
+// result back into the original edges.
+//
+// Edges are undirected (like Graph), so one upward arc list serves both
+// search directions.
+
+struct CHBuildOptions {
+    int witnessSettleLimit = 500;   // nodes settled per witness search while contracting
+    int prioritySettleLimit = 50;   // cheaper limit used when only estimating priorities
+};
+
+class CHQuery;
+
+class ContractionHierarchy {
+private:
+    vector<int> ids;                  // dense index -> node id
+    unordered_map<int, int> indexOf;  // node id -> dense index
+    vector<int> rank;                 // position in the contraction order
+
+    // upward arcs in CSR form, arcs of v are [upOffset[v], upOffset[v + 1])
+    vector<int> upOffset;
+    vector<int> upTarget;
+    vector<double> upCost;
+    vector<int> upMiddle;             // bypassed node for shortcuts, -1 for original edges
+
+    uint64_t fingerprint = 0;
+    int shortcuts = 0;
+
+    friend class CHQuery;
+
+    struct Arc {
+        int to;
+        double cost;
+        int middle;
+    };
+
+    static void addOrImprove(vector<Arc>& arcs, int to, double cost, int middle) {
+        for (auto& arc : arcs) {
+            if (arc.to == to) {
+                if (cost < arc.cost) {
+                    arc.cost = cost;
+                    arc.middle = middle;
+                }
+                return;
+            }
+        }
+        arcs.push_back({to, cost, middle});
+    }
+
+    // Dijkstra on the not yet contracted graph, used to look for witness paths
+    class WitnessSearch {
+    private:
+        vector<double> dist;
+        vector<int> touched;
+        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+
+    public:
+        explicit WitnessSearch(int n) : dist(n, INF) {}
+
+        void run(const vector<vector<Arc>>& adj, int source, int excluded, double maxCost, int settleLimit) {
+            for (int v : touched) dist[v] = INF;
+            touched.clear();
+            while (!pq.empty()) pq.pop();
+
+            dist[source] = 0.0;
+            touched.push_back(source);
+            pq.push({0.0, source});
+
+            int settled = 0;
+            while (!pq.empty()) {
+                auto [d, u] = pq.top();
+                pq.pop();
+
+                if (d > dist[u]) continue;
+                if (d > maxCost || ++settled > settleLimit) break;
+
+                for (const auto& arc : adj[u]) {
+                    if (arc.to == excluded) continue;
+                    double nd = d + arc.cost;
+                    if (nd < dist[arc.to]) {
+                        if (dist[arc.to] == INF) touched.push_back(arc.to);
+                        dist[arc.to] = nd;
+                        pq.push({nd, arc.to});
+                    }
+                }
+            }
+        }
+
+        double distanceTo(int v) const { return dist[v]; }
+    };
+
+    struct Shortcut {
+        int u;
+        int w;
+        double cost;
+    };
+
+    // shortcuts needed if v were contracted now
+    static void findShortcuts(const vector<vector<Arc>>& adj, int v, WitnessSearch& search, int settleLimit, vector<Shortcut>& out) {
+        out.clear();
+        const vector<Arc>& arcs = adj[v];
+
+        for (int i = 0; i + 1 < (int)arcs.size(); i++) {
+            double maxVia = 0.0;
+            for (int j = i + 1; j < (int)arcs.size(); j++) maxVia = max(maxVia, arcs[j].cost);
+
+            search.run(adj, arcs[i].to, v, arcs[i].cost + maxVia, settleLimit);
+
+            for (int j = i + 1; j < (int)arcs.size(); j++) {
+                double via = arcs[i].cost + arcs[j].cost;
+                if (search.distanceTo(arcs[j].to) > via) out.push_back({arcs[i].to, arcs[j].to, via});
+            }
+        }
+    }
+
+    static uint64_t fingerprintOf(const Graph& graph) {
+        uint64_t hash = 1469598103934665603ULL; // FNV-1a
+        auto mix = [&](const void* data, size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+
+        vector<int> nodeIds = graph.getAllNodeIds();
+        sort(nodeIds.begin(), nodeIds.end());
+        for (int id : nodeIds) mix(&id, sizeof(id));
+
+        for (const auto& edge : graph.getEdges()) {
+            mix(&edge.u, sizeof(edge.u));
+            mix(&edge.v, sizeof(edge.v));
+            mix(&edge.cost, sizeof(edge.cost));
+        }
+        return hash;
+    }
+
+public:
+    ContractionHierarchy() = default;
+
+    explicit ContractionHierarchy(const Graph& graph, const CHBuildOptions& options = CHBuildOptions()) {
+        build(graph, options);
+    }
+
+    void build(const Graph& graph, const CHBuildOptions& options = CHBuildOptions()) {
+        DenseGraph dense(graph);
+        ids = move(dense.ids);
+        indexOf = move(dense.indexOf);
+
+        int n = ids.size();
+        fingerprint = fingerprintOf(graph);
+        shortcuts = 0;
+
+        // parallel edges collapse to the cheapest, self loops are dropped
+        vector<vector<Arc>> adj(n);
+        for (int a = 0; a < n; a++) {
+            for (int k = dense.offset[a]; k < dense.offset[a + 1]; k++) {
+                if (dense.target[k] != a) addOrImprove(adj[a], dense.target[k], dense.cost[k], -1);
+            }
+        }
+
+        WitnessSearch search(n);
+        vector<Shortcut> found;
+        vector<int> deletedNeighbours(n, 0);
+        vector<char> contracted(n, 0);
+        vector<vector<Arc>> upward(n);
+        rank.assign(n, 0);
+
+        vector<int> level(n, 0);
+
+        // edge difference, contracted neighbours and hierarchy depth, the
+        // last two keep the order spread out and the upward searches shallow
+        auto priorityOf = [&](int v) {
+            findShortcuts(adj, v, search, options.prioritySettleLimit, found);
+            return 2 * ((int)found.size() - (int)adj[v].size()) + deletedNeighbours[v] + level[v];
+        };
+
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> order;
+        for (int v = 0; v < n; v++) order.push({priorityOf(v), v});
+
+        int nextRank = 0;
+        while (!order.empty()) {
+            int v = order.top().second;
+            order.pop();
+
+            if (contracted[v]) continue;
+
+            // lazy update: priorities of neighbours go stale as we contract
+            int priority = priorityOf(v);
+            if (!order.empty() && priority > order.top().first) {
+                order.push({priority, v});
+                continue;
+            }
+
+            findShortcuts(adj, v, search, options.witnessSettleLimit, found);
+
+            contracted[v] = 1;
+            rank[v] = nextRank++;
+            upward[v] = adj[v];
+
+            for (const auto& arc : adj[v]) {
+                vector<Arc>& back = adj[arc.to];
+                for (int k = 0; k < (int)back.size(); k++) {
+                    if (back[k].to == v) {
+                        back[k] = back.back();
+                        back.pop_back();
+                        break;
+                    }
+                }
+                deletedNeighbours[arc.to]++;
+                level[arc.to] = max(level[arc.to], level[v] + 1);
+            }
+
+            for (const auto& s : found) {
+                addOrImprove(adj[s.u], s.w, s.cost, v);
+                addOrImprove(adj[s.w], s.u, s.cost, v);
+            }
+            shortcuts += found.size();
+
+            adj[v].clear();
+            adj[v].shrink_to_fit();
+        }
+
+        upOffset.assign(n + 1, 0);
+        for (int v = 0; v < n; v++) upOffset[v + 1] = upOffset[v] + upward[v].size();
+
+        upTarget.resize(upOffset[n]);
+        upCost.resize(upOffset[n]);
+        upMiddle.resize(upOffset[n]);
+        for (int v = 0; v < n; v++) {
+            int k = upOffset[v];
+            for (const auto& arc : upward[v]) {
+                upTarget[k] = arc.to;
+                upCost[k] = arc.cost;
+                upMiddle[k] = arc.middle;
+                k++;
+            }
+        }
+    }
+
+    int numNodes() const { return ids.size(); }
+    int numArcs() const { return upTarget.size(); }
+    int numShortcuts() const { return shortcuts; }
+
+    // true if this hierarchy was built from exactly this graph
+    bool matches(const Graph& graph) const {
+        return !ids.empty() && fingerprint == fingerprintOf(graph);
+    }
+
+    // Binary layout, native byte order:
+    //   "DRCH", u32 version, u64 fingerprint, u32 nodes, u32 arcs, u32 shortcuts,
+    //   i32 ids[nodes], i32 rank[nodes], i32 upOffset[nodes + 1],
+    //   i32 upTarget[arcs], f64 upCost[arcs], i32 upMiddle[arcs]
+    static const uint32_t VERSION = 1;
+
+    bool save(const string& filename) const {
+        FILE* file = fopen(filename.c_str(), "wb");
+        if (!file) {
+            cerr << "Cannot create file: " << filename << endl;
+            return false;
+        }
+
+        uint32_t version = VERSION;
+        uint32_t nodes = ids.size();
+        uint32_t arcs = upTarget.size();
+        uint32_t shortcutCount = shortcuts;
+
+        bool ok = fwrite("DRCH", 1, 4, file) == 4;
+        ok = ok && fwrite(&version, sizeof(version), 1, file) == 1;
+        ok = ok && fwrite(&fingerprint, sizeof(fingerprint), 1, file) == 1;
+        ok = ok && fwrite(&nodes, sizeof(nodes), 1, file) == 1;
+        ok = ok && fwrite(&arcs, sizeof(arcs), 1, file) == 1;
+        ok = ok && fwrite(&shortcutCount, sizeof(shortcutCount), 1, file) == 1;
+        ok = ok && fwrite(ids.data(), sizeof(int), nodes, file) == nodes;
+        ok = ok && fwrite(rank.data(), sizeof(int), nodes, file) == nodes;
+        ok = ok && fwrite(upOffset.data(), sizeof(int), nodes + 1, file) == nodes + 1;
+        ok = ok && fwrite(upTarget.data(), sizeof(int), arcs, file) == arcs;
+        ok = ok && fwrite(upCost.data(), sizeof(double), arcs, file) == arcs;
+        ok = ok && fwrite(upMiddle.data(), sizeof(int), arcs, file) == arcs;
+
+        fclose(file);
+        return ok;
+    }
+
+    // throws on anything that does not describe a valid hierarchy, so
+    // loadOrBuildHierarchy falls back to a rebuild
+    void load(const string& filename) {
+        BinaryReader in(filename, "hierarchy");
+        in.header("DRCH", VERSION, VERSION);
+
+        fingerprint = in.get<uint64_t>();
+        uint32_t nodes = in.get<uint32_t>();
+        uint32_t arcs = in.get<uint32_t>();
+        shortcuts = in.get<uint32_t>();
+
+        // ids, rank, upOffset and the three arc arrays
+        in.expect((uint64_t)nodes * 3 * sizeof(int) + sizeof(int) + (uint64_t)arcs * (2 * sizeof(int) + sizeof(double)), 1);
+
+        ids.resize(nodes);
+        rank.resize(nodes);
+        upOffset.resize(nodes + 1);
+        upTarget.resize(arcs);
+        upCost.resize(arcs);
+        upMiddle.resize(arcs);
+
+        in.read(ids.data(), sizeof(int) * nodes);
+        in.read(rank.data(), sizeof(int) * nodes);
+        in.read(upOffset.data(), sizeof(int) * (nodes + 1));
+        in.read(upTarget.data(), sizeof(int) * arcs);
+        in.read(upCost.data(), sizeof(double) * arcs);
+        in.read(upMiddle.data(), sizeof(int) * arcs);
+
+        if (upOffset[0] != 0 || upOffset[nodes] != (int)arcs) throw in.error("Corrupt");
+        for (uint32_t i = 0; i < nodes; i++) {
+            if (upOffset[i] > upOffset[i + 1]) throw in.error("Corrupt");
+        }
+        for (uint32_t e = 0; e < arcs; e++) {
+            if (upTarget[e] < 0 || upTarget[e] >= (int)nodes) throw in.error("Corrupt");
+            if (upMiddle[e] < -1 || upMiddle[e] >= (int)nodes) throw in.error("Corrupt");
+        }
+
+        indexOf.clear();
+        for (int i = 0; i < (int)ids.size(); i++) indexOf[ids[i]] = i;
+    }
+};
+
+// Per-thread query state for a ContractionHierarchy. The hierarchy itself is
+// read-only, so any number of CHQuery objects can share one.
+class CHQuery {
+private:
+    const ContractionHierarchy& ch;
+
+    vector<double> dist[2];
+    vector<int> parent[2];     // previous node on the upward search tree
+    vector<int> parentArc[2];  // arc index used to reach the node
+    vector<int> touched;
+    priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq[2];
+
+    int meeting = -1;
+
+    void reset() {
+        for (int v : touched) {
+            dist[0][v] = dist[1][v] = INF;
+            parent[0][v] = parent[1][v] = -1;
+        }
+        touched.clear();
+        for (auto& q : pq) {
+            while (!q.empty()) q.pop();
+        }
+        meeting = -1;
+    }
+
+    // bidirectional upward Dijkstra, returns the distance and sets meeting
+    double search(int s, int t) {
+        reset();
+
+        if (s == t) {
+            meeting = s;
+            return 0.0;
+        }
+
+        dist[0][s] = 0.0;
+        dist[1][t] = 0.0;
+        touched.push_back(s);
+        touched.push_back(t);
+        pq[0].push({0.0, s});
+        pq[1].push({0.0, t});
+
+        double best = INF;
+
+        while (!pq[0].empty() || !pq[1].empty()) {
+            for (int side = 0; side < 2; side++) {
+                auto& q = pq[side];
+                if (q.empty()) continue;
+
+                auto [d, u] = q.top();
+                if (d >= best) {
+                    while (!q.empty()) q.pop();
+                    continue;
+                }
+                q.pop();
+
+                if (d > dist[side][u]) continue;
+
+                if (dist[1 - side][u] != INF && d + dist[1 - side][u] < best) {
+                    best = d + dist[1 - side][u];
+                    meeting = u;
+                }
+
+                // stall-on-demand: a higher node already offers a shorter way
+                // to u, so nothing reached through u can be on a shortest path
+                bool stalled = false;
+                for (int k = ch.upOffset[u]; k < ch.upOffset[u + 1]; k++) {
+                    if (dist[side][ch.upTarget[k]] + ch.upCost[k] < d) {
+                        stalled = true;
+                        break;
+                    }
+                }
+                if (stalled) continue;
+
+                for (int k = ch.upOffset[u]; k < ch.upOffset[u + 1]; k++) {
+                    int v = ch.upTarget[k];
+                    double nd = d + ch.upCost[k];
+                    if (nd < dist[side][v]) {
+                        if (dist[0][v] == INF && dist[1][v] == INF) touched.push_back(v);
+                        dist[side][v] = nd;
+                        parent[side][v] = u;
+                        parentArc[side][v] = k;
+                        pq[side].push({nd, v});
+
+                        if (dist[1 - side][v] != INF && nd + dist[1 - side][v] < best) {
+                            best = nd + dist[1 - side][v];
+                            meeting = v;
+                        }
+                    }
+                }
+            }
+        }
+
+        return best;
+    }
+
+    // arc between a lower ranked node and a higher ranked one
+    int findArc(int low, int high) const {
+        for (int k = ch.upOffset[low]; k < ch.upOffset[low + 1]; k++) {
+            if (ch.upTarget[k] == high) return k;
+        }
+        return -1;
+    }
+
+    // appends the original nodes after a on the arc a-b, ending with b
+    void unpack(int a, int b, int middle, vector<int>& out) const {
+        if (middle < 0) {
+            out.push_back(ch.ids[b]);
+            return;
+        }
+        unpack(a, middle, ch.upMiddle[findArc(middle, a)], out);
+        unpack(middle, b, ch.upMiddle[findArc(middle, b)], out);
+    }
+
+public:
+    explicit CHQuery(const ContractionHierarchy& ch) : ch(ch) {
+        int n = ch.numNodes();
+        for (int side = 0; side < 2; side++) {
+            dist[side].assign(n, INF);
+            parent[side].assign(n, -1);
+            parentArc[side].assign(n, -1);
+        }
+    }
+
+    // shortest path cost between two node ids, INF when there is none
+    double distance(int from, int to) {
+        auto a = ch.indexOf.find(from);
+        auto b = ch.indexOf.find(to);
+        if (a == ch.indexOf.end() || b == ch.indexOf.end()) return INF;
+        return search(a->second, b->second);
+    }
+
+    // full shortest path as node ids (same shape as astar()), {} when none
+    vector<int> path(int from, int to) {
+        auto a = ch.indexOf.find(from);
+        auto b = ch.indexOf.find(to);
+        if (a == ch.indexOf.end() || b == ch.indexOf.end()) return {};
+
+        if (search(a->second, b->second) == INF) return {};
+
+        // forward half: from up to the meeting node
+        vector<int> chain;
+        for (int v = meeting; v != -1; v = parent[0][v]) chain.push_back(v);
+        reverse(chain.begin(), chain.end());
+
+        vector<int> result = {from};
+        for (int i = 0; i + 1 < (int)chain.size(); i++) {
+            int v = chain[i + 1];
+            unpack(chain[i], v, ch.upMiddle[parentArc[0][v]], result);
+        }
+
+        // backward half: down from the meeting node to to
+        for (int v = meeting; parent[1][v] != -1; v = parent[1][v]) {
+            unpack(v, parent[1][v], ch.upMiddle[parentArc[1][v]], result);
+        }
+
+        return result;
+    }
+};
+
+// hierarchy file stored next to a dataset, datasets/input5.json -> datasets/input5.ch
+string hierarchyPathFor(const string& datasetFile) {
+    size_t dot = datasetFile.find_last_of('.');
+    size_t slash = datasetFile.find_last_of("/\\");
+    if (dot == string::npos || (slash != string::npos && dot < slash)) return datasetFile + ".ch";
+    return datasetFile.substr(0, dot) + ".ch";
+}
+
+// Loads the saved hierarchy if it was built for this graph, otherwise builds
+// a new one and saves it in its place.
+ContractionHierarchy loadOrBuildHierarchy(const Graph& graph, const string& filename) {
+    ContractionHierarchy ch;
+
+    try {
+        ch.load(filename);
+        if (ch.matches(graph)) return ch;
+    } catch (const exception&) {
+        // missing or stale, rebuilt below
+    }
+
+    ch.build(graph);
+    ch.save(filename);
+    return ch;
+}
+
+// greedy allocation with travel costs from the hierarchy instead of A*
+vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehicles, const ContractionHierarchy& ch) {
+    CHQuery query(ch);
+
+    return allocateVehiclesWith(graph, vehicles, [&](int from, int to) {
+        return query.distance(from, to);
+    }, "CH query");
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef DENSE_GRAPH_H
+#define DENSE_GRAPH_H
+
+#include "Graph.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+using namespace std;
+
+// The graph renumbered to dense indices (node ids in ascending order) with
+// its edges as arrays in CSR form, both directions: the arcs of index i are
+// [offset[i], offset[i + 1]). Edges touching a node that is not in the graph
+// are skipped. This is the layout every search that runs many Dijkstras
+// works on (tail trees, clustering, hierarchy build); it is read-only once
+// built, so one copy can be shared between threads.
+
+struct DenseGraph {
+    vector<int> ids;                  // dense index -> node id
+    unordered_map<int, int> indexOf;  // node id -> dense index
+    vector<int> offset;
+    vector<int> target;
+    vector<double> cost;
+
+    DenseGraph() = default;
+
+    explicit DenseGraph(const Graph& graph) {
+        ids = graph.getAllNodeIds();
+        sort(ids.begin(), ids.end());
+        for (int i = 0; i < (int)ids.size(); i++) indexOf[ids[i]] = i;
+
+        int n = ids.size();
+        offset.assign(n + 1, 0);
+        for (const auto& edge : graph.getEdges()) {
+            int a = indexOfNode(edge.u);
+            int b = indexOfNode(edge.v);
+            if (a < 0 || b < 0) continue; // edge to a node that is not in the graph
+            offset[a + 1]++;
+            offset[b + 1]++;
+        }
+        for (int i = 0; i < n; i++) offset[i + 1] += offset[i];
+
+        target.resize(offset[n]);
+        cost.resize(offset[n]);
+        vector<int> fill(offset.begin(), offset.end() - 1);
+        for (const auto& edge : graph.getEdges()) {
+            int a = indexOfNode(edge.u);
+            int b = indexOfNode(edge.v);
+            if (a < 0 || b < 0) continue;
+            target[fill[a]] = b;
+            cost[fill[a]++] = edge.cost;
+            target[fill[b]] = a;
+            cost[fill[b]++] = edge.cost;
+        }
+    }
+
+    int size() const { return ids.size(); }
+    int idOf(int index) const { return ids[index]; }
+
+    // -1 when the node is not in the graph
+    int indexOfNode(int id) const {
+        auto it = indexOf.find(id);
+        return it == indexOf.end() ? -1 : it->second;
+    }
+};
+
+#endif
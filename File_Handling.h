@@ -0,0 +1,390 @@
+#ifndef FILE_HANDLING_H
+#define FILE_HANDLING_H
+
+#include "Graph.h"
+#include "Greedy_Allocation.h"
+#include "Multi_Objective_Algorithm.h"
+#include "Result_Writer.h"
+#include "Binary_Reader.h"
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <iomanip>
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+#pragma region FileHandling
+
+Graph loadGraphFromJSON(const string& filename) {
+    Graph graph;
+    ifstream file(filename);
+    
+    if (!file.is_open()) {
+        throw runtime_error("Cannot open file: " + filename);
+    }
+    
+    string content, line;
+    while (getline(file, line)) {
+        content += line;
+    }
+    file.close();
+    
+    int nodesPos = (int)content.find("\"nodes\"");
+    if (nodesPos != (int)string::npos) {
+        int start = (int)content.find('[', nodesPos);
+        int end = (int)content.find(']', start);
+        string nodesStr = content.substr(start + 1, end - start - 1);
+        
+        int nodeStart = 0;
+        while ((nodeStart = (int)nodesStr.find('{', nodeStart)) != (int)string::npos) {
+            int nodeEnd = (int)nodesStr.find('}', nodeStart);
+            string nodeStr = nodesStr.substr(nodeStart, nodeEnd - nodeStart + 1);
+            
+            int id = 0, demand = 0, priority = 0;
+            
+            // Extract id
+            int idPos = (int)nodeStr.find("\"id\"");
+            if (idPos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', idPos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                id = stoi(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract demand
+            int demandPos = (int)nodeStr.find("\"demand\"");
+            if (demandPos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', demandPos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                demand = stoi(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract priority
+            int priorityPos = (int)nodeStr.find("\"priority\"");
+            if (priorityPos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', priorityPos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                priority = stoi(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Optional time window and service time
+            double readyTime = 0.0, dueTime = INF, serviceTime = 0.0;
+
+            int readyPos = (int)nodeStr.find("\"ready_time\"");
+            if (readyPos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', readyPos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                readyTime = stod(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+
+            int duePos = (int)nodeStr.find("\"due_time\"");
+            if (duePos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', duePos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                dueTime = stod(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+
+            int servicePos = (int)nodeStr.find("\"service_time\"");
+            if (servicePos != (int)string::npos) {
+                int colon = (int)nodeStr.find(':', servicePos);
+                int comma = (int)nodeStr.find_first_of(",}", colon);
+                serviceTime = stod(nodeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            graph.addNode(Node(id, demand, priority, readyTime, dueTime, serviceTime));
+            nodeStart = nodeEnd + 1;
+        }
+    }
+    
+    // Parse edges
+    int edgesPos = (int)content.find("\"edges\"");
+    if (edgesPos != (int)string::npos) {
+        int start = (int)content.find('[', edgesPos);
+        int end = (int)content.find(']', start);
+        string edgesStr = content.substr(start + 1, end - start - 1);
+        
+        int edgeStart = 0;
+        while ((edgeStart = (int)edgesStr.find('{', edgeStart)) != (int)string::npos) {
+            int edgeEnd = (int)edgesStr.find('}', edgeStart);
+            string edgeStr = edgesStr.substr(edgeStart, edgeEnd - edgeStart + 1);
+            
+            int u = 0, v = 0;
+            double cost = 0.0, reliability = 1.0;
+            
+            // Extract u
+            int uPos = (int)edgeStr.find("\"u\"");
+            if (uPos != (int)string::npos) {
+                int colon = (int)edgeStr.find(':', uPos);
+                int comma = (int)edgeStr.find(',', colon);
+                u = stoi(edgeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract v
+            int vPos = (int)edgeStr.find("\"v\"");
+            if (vPos != (int)string::npos) {
+                int colon = (int)edgeStr.find(':', vPos);
+                int comma = (int)edgeStr.find(',', colon);
+                v = stoi(edgeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract cost
+            int costPos = (int)edgeStr.find("\"cost\"");
+            if (costPos != (int)string::npos) {
+                int colon = (int)edgeStr.find(':', costPos);
+                int comma = (int)edgeStr.find(',', colon);
+                cost = stod(edgeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract reliability
+            int relPos = (int)edgeStr.find("\"reliability\"");
+            if (relPos != (int)string::npos) {
+                int colon = (int)edgeStr.find(':', relPos);
+                int comma = (int)edgeStr.find_first_of(",}", colon);
+                reliability = stod(edgeStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            graph.addEdge(Edge(u, v, cost, reliability));
+            edgeStart = edgeEnd + 1;
+        }
+    }
+    
+    return graph;
+}
+
+// Parse the "vehicles" array out of a JSON document held in memory
+vector<Vehicle> parseVehiclesFromJSON(const string& content) {
+    vector<Vehicle> vehicles;
+    
+    // Parse vehicles
+    int vehiclesPos = (int)content.find("\"vehicles\"");
+    if (vehiclesPos != (int)string::npos) {
+        int start = (int)content.find('[', vehiclesPos);
+        int end = (int)content.find(']', start);
+        string vehiclesStr = content.substr(start + 1, end - start - 1);
+        
+        int vehicleStart = 0;
+        while ((vehicleStart = (int)vehiclesStr.find('{', vehicleStart)) != (int)string::npos) {
+            int vehicleEnd = (int)vehiclesStr.find('}', vehicleStart);
+            string vehicleStr = vehiclesStr.substr(vehicleStart, vehicleEnd - vehicleStart + 1);
+            
+            int id = 0, capacity = 0;
+            
+            // Extract id
+            int idPos = (int)vehicleStr.find("\"id\"");
+            if (idPos != (int)string::npos) {
+                int colon = (int)vehicleStr.find(':', idPos);
+                int comma = (int)vehicleStr.find_first_of(",}", colon);
+                id = stoi(vehicleStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            // Extract capacity
+            int capPos = (int)vehicleStr.find("\"capacity\"");
+            if (capPos != (int)string::npos) {
+                int colon = (int)vehicleStr.find(':', capPos);
+                int comma = (int)vehicleStr.find_first_of(",}", colon);
+                capacity = stoi(vehicleStr.substr(colon + 1, comma - colon - 1));
+            }
+            
+            vehicles.push_back(Vehicle(id, capacity));
+            vehicleStart = vehicleEnd + 1;
+        }
+    }
+    
+    return vehicles;
+}
+
+// Load vehicles from JSON file
+vector<Vehicle> loadVehiclesFromJSON(const string& filename) {
+    ifstream file(filename);
+    
+    if (!file.is_open()) {
+        throw runtime_error("Cannot open file: " + filename);
+    }
+    
+    string content, line;
+    while (getline(file, line)) {
+        content += line;
+    }
+    file.close();
+    
+    return parseVehiclesFromJSON(content);
+}
+
+// Save results to JSON file, reusing costs already computed by the caller
+void saveResultsToJSON(const string& filename,
+                      const vector<Vehicle>& vehicles,
+                      const vector<RouteCost>& costs) {
+    writeWholeFile(filename, formatResultsJSON(vehicles, costs));
+}
+
+// Save results to JSON file
+void saveResultsToJSON(const string& filename,
+                      const vector<Vehicle>& vehicles,
+                      const Graph& graph) {
+    vector<RouteCost> costs;
+    costs.reserve(vehicles.size());
+    for (const auto& vehicle : vehicles) {
+        costs.push_back(calculateRouteCost(graph, vehicle.route, vehicle.capacity, vehicle.currentLoad));
+    }
+    saveResultsToJSON(filename, vehicles, costs);
+}
+
+// Save a graph and fleet in the datasets/*.json layout
+bool saveScenarioToJSON(const string& filename, const Graph& graph, const vector<Vehicle>& vehicles) {
+    vector<int> ids = graph.getAllNodeIds();
+    sort(ids.begin(), ids.end());
+
+    string out;
+    out.reserve(64 + ids.size() * 48 + graph.numEdges() * 64 + vehicles.size() * 32);
+
+    out += "{\n  \"nodes\": [\n";
+    for (int i = 0; i < (int)ids.size(); i++) {
+        const Node* node = graph.getNode(ids[i]);
+        out += "    { \"id\": ";
+        appendInt(out, node->id);
+        out += ", \"demand\": ";
+        appendInt(out, node->demand);
+        out += ", \"priority\": ";
+        appendInt(out, node->priority);
+        if (node->hasTimeWindow()) {
+            out += ", \"ready_time\": ";
+            appendFixed2(out, node->readyTime);
+            if (node->dueTime != INF) {
+                out += ", \"due_time\": ";
+                appendFixed2(out, node->dueTime);
+            }
+            out += ", \"service_time\": ";
+            appendFixed2(out, node->serviceTime);
+        }
+        out += " }";
+        if (i < (int)ids.size() - 1) out += ',';
+        out += '\n';
+    }
+
+    out += "  ],\n  \"edges\": [\n";
+    const vector<Edge>& edges = graph.getEdges();
+    for (int i = 0; i < (int)edges.size(); i++) {
+        out += "    { \"u\": ";
+        appendInt(out, edges[i].u);
+        out += ", \"v\": ";
+        appendInt(out, edges[i].v);
+        out += ", \"cost\": ";
+        if (edges[i].cost == floor(edges[i].cost)) appendInt(out, (long long)edges[i].cost);
+        else appendFixed2(out, edges[i].cost);
+        out += ", \"reliability\": ";
+        appendFixed2(out, edges[i].reliability);
+        out += " }";
+        if (i < (int)edges.size() - 1) out += ',';
+        out += '\n';
+    }
+
+    out += "  ],\n  \"vehicles\": [\n";
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        out += "    { \"id\": ";
+        appendInt(out, vehicles[i].id);
+        out += ", \"capacity\": ";
+        appendInt(out, vehicles[i].capacity);
+        out += " }";
+        if (i < (int)vehicles.size() - 1) out += ',';
+        out += '\n';
+    }
+    out += "  ]\n}\n";
+
+    return writeWholeFile(filename, out);
+}
+
+// Binary scenario, native byte order:
+//   "DRGB", u32 version, u32 nodes, u32 edges, u32 vehicles,
+//   nodes    (i32 id, i32 demand, i32 priority,
+//             f64 readyTime, f64 dueTime, f64 serviceTime)   time fields since version 2
+//   edges    (i32 u, i32 v, f64 cost, f64 reliability)
+//   vehicles (i32 id, i32 capacity)
+const uint32_t SCENARIO_BINARY_VERSION = 2;
+
+bool saveScenarioToBinary(const string& filename, const Graph& graph, const vector<Vehicle>& vehicles) {
+    vector<int> ids = graph.getAllNodeIds();
+    sort(ids.begin(), ids.end());
+    const vector<Edge>& edges = graph.getEdges();
+
+    string out = "DRGB";
+    out.reserve(20 + ids.size() * 36 + edges.size() * 24 + vehicles.size() * 8);
+    appendPod<uint32_t>(out, SCENARIO_BINARY_VERSION);
+    appendPod<uint32_t>(out, ids.size());
+    appendPod<uint32_t>(out, edges.size());
+    appendPod<uint32_t>(out, vehicles.size());
+
+    for (int id : ids) {
+        const Node* node = graph.getNode(id);
+        appendPod<int32_t>(out, node->id);
+        appendPod<int32_t>(out, node->demand);
+        appendPod<int32_t>(out, node->priority);
+        appendPod<double>(out, node->readyTime);
+        appendPod<double>(out, node->dueTime);
+        appendPod<double>(out, node->serviceTime);
+    }
+    for (const auto& edge : edges) {
+        appendPod<int32_t>(out, edge.u);
+        appendPod<int32_t>(out, edge.v);
+        appendPod<double>(out, edge.cost);
+        appendPod<double>(out, edge.reliability);
+    }
+    for (const auto& vehicle : vehicles) {
+        appendPod<int32_t>(out, vehicle.id);
+        appendPod<int32_t>(out, vehicle.capacity);
+    }
+
+    return writeWholeFile(filename, out);
+}
+
+// Load a scenario written by saveScenarioToBinary
+void loadScenarioFromBinary(const string& filename, Graph& graph, vector<Vehicle>& vehicles) {
+    BinaryReader in(filename, "scenario");
+    uint32_t version = in.header("DRGB", 1, SCENARIO_BINARY_VERSION);
+
+    uint32_t numNodes = in.get<uint32_t>();
+    uint32_t numEdges = in.get<uint32_t>();
+    uint32_t numVehicles = in.get<uint32_t>();
+
+    size_t nodeSize = (version >= 2) ? 36 : 12;
+    // fixed size records, so the counts must add up to what the file holds
+    in.expect((uint64_t)numNodes * nodeSize + (uint64_t)numEdges * 24 + (uint64_t)numVehicles * 8, 1);
+
+    graph = Graph();
+    vehicles.clear();
+    vehicles.reserve(numVehicles);
+
+    for (uint32_t i = 0; i < numNodes; i++) {
+        int32_t id = in.get<int32_t>();
+        int32_t demand = in.get<int32_t>();
+        int32_t priority = in.get<int32_t>();
+
+        double readyTime = 0.0, dueTime = INF, serviceTime = 0.0;
+        if (version >= 2) {
+            readyTime = in.get<double>();
+            dueTime = in.get<double>();
+            serviceTime = in.get<double>();
+        }
+        graph.addNode(Node(id, demand, priority, readyTime, dueTime, serviceTime));
+    }
+    for (uint32_t i = 0; i < numEdges; i++) {
+        int32_t u = in.get<int32_t>();
+        int32_t v = in.get<int32_t>();
+        double cost = in.get<double>();
+        double reliability = in.get<double>();
+        graph.addEdge(Edge(u, v, cost, reliability));
+    }
+    for (uint32_t i = 0; i < numVehicles; i++) {
+        int32_t id = in.get<int32_t>();
+        int32_t capacity = in.get<int32_t>();
+        vehicles.push_back(Vehicle(id, capacity));
+    }
+}
+#pragma endregion
+
+#endif
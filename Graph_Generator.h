@@ -0,0 +1,358 @@
+#ifndef GRAPH_GENERATOR_H
+#define GRAPH_GENERATOR_H
+
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Greedy_Allocation.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+using namespace std;
+
+// Deterministic synthetic scenarios for scale testing.
+// The same (config, seed) gives the same graph on every platform: we use our
+// own SplitMix64 generator and integer arithmetic instead of the <random>
+// distributions, whose output differs between standard libraries.
+
+enum class GraphShape {
+    GRID,       // road-like lattice with dropped streets and a few diagonals
+    GEOMETRIC   // random points joined to their k nearest neighbours
+};
+
+enum class DemandDistribution {
+    UNIFORM,    // every value in [min, max] equally likely
+    SKEWED      // mostly small values, occasional large ones
+};
+
+struct GeneratorConfig {
+    GraphShape shape = GraphShape::GRID;
+    int numNodes = 1000;           // including depot 0
+    uint64_t seed = 1;
+
+    // GRID: probability (percent) that a non-spine street is kept
+    int keepStreetPercent = 85;
+    int diagonalPercent = 5;
+
+    // GEOMETRIC: neighbours per node
+    int nearestNeighbours = 4;
+
+    int minEdgeCost = 1;
+    int maxEdgeCost = 20;          // cost = distance scaled into this range, plus noise
+    int minReliabilityPercent = 70;
+
+    DemandDistribution demand = DemandDistribution::UNIFORM;
+    int minDemand = 1;
+    int maxDemand = 5;
+
+    DemandDistribution priority = DemandDistribution::UNIFORM;
+    int maxPriority = 5;
+
+    // time windows: percentage of customers with a window of the given
+    // width somewhere in [0, horizon], plus a service time per customer
+    int timeWindowPercent = 0;
+    int horizon = 1000;
+    int minWindowWidth = 100;
+    int maxWindowWidth = 300;
+    int minServiceTime = 0;
+    int maxServiceTime = 0;
+
+    int numVehicles = 0;           // 0 = numNodes / nodesPerVehicle
+    int nodesPerVehicle = 70;
+    int capacitySlackPercent = 110; // fleet capacity relative to total demand
+};
+
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // uniform integer in [lo, hi]
+    int range(int lo, int hi) {
+        if (hi <= lo) return lo;
+        return lo + (int)(next() % (uint64_t)(hi - lo + 1));
+    }
+
+    bool percent(int p) { return (int)(next() % 100) < p; }
+
+    // uniform in [0, 1)
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+int drawValue(SplitMix64& rng, DemandDistribution dist, int lo, int hi) {
+    if (dist == DemandDistribution::UNIFORM) return rng.range(lo, hi);
+
+    // skewed: each step up is taken with probability 1/2
+    int value = lo;
+    while (value < hi && rng.percent(50)) value++;
+    return value;
+}
+
+class DisjointSet {
+private:
+    vector<int> parent;
+
+public:
+    explicit DisjointSet(int n) : parent(n) { iota(parent.begin(), parent.end(), 0); }
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        parent[b] = a;
+        return true;
+    }
+};
+
+// cost from a euclidean length in [0, maxLength], with +-20% noise
+double edgeCostFor(SplitMix64& rng, const GeneratorConfig& config, double length, double maxLength) {
+    double span = config.maxEdgeCost - config.minEdgeCost;
+    double scaled = config.minEdgeCost + span * min(1.0, length / maxLength);
+    double noise = 0.8 + 0.4 * rng.unit();
+    return max((double)config.minEdgeCost, round(scaled * noise));
+}
+
+double edgeReliabilityFor(SplitMix64& rng, const GeneratorConfig& config) {
+    return rng.range(config.minReliabilityPercent, 100) / 100.0;
+}
+
+void addGeneratedEdge(Graph& graph, SplitMix64& rng, const GeneratorConfig& config, int u, int v, double length, double maxLength) {
+    double c = edgeCostFor(rng, config, length, maxLength);
+    graph.addEdge(Edge(u, v, c, edgeReliabilityFor(rng, config)));
+}
+
+void generateGridEdges(Graph& graph, SplitMix64& rng, const GeneratorConfig& config) {
+    int n = config.numNodes;
+    int cols = max(1, (int)ceil(sqrt((double)n)));
+
+    // streets along row 0 and column 0 are always kept, the rest are dropped
+    // at random; anything that gets cut off is reattached below
+    for (int id = 0; id < n; id++) {
+        int r = id / cols;
+        int c = id % cols;
+
+        int right = id + 1;
+        if (c + 1 < cols && right < n) {
+            if (r == 0 || c == 0 || rng.percent(config.keepStreetPercent)) {
+                addGeneratedEdge(graph, rng, config, id, right, 1.0, 1.5);
+            }
+        }
+
+        int down = id + cols;
+        if (down < n) {
+            if (c == 0 || rng.percent(config.keepStreetPercent)) {
+                addGeneratedEdge(graph, rng, config, id, down, 1.0, 1.5);
+            }
+        }
+
+        int diagonal = down + 1;
+        if (c + 1 < cols && diagonal < n && rng.percent(config.diagonalPercent)) {
+            addGeneratedEdge(graph, rng, config, id, diagonal, sqrt(2.0), 1.5);
+        }
+    }
+
+    // reattach cut off nodes to the node above them (or to the left in row 0)
+    DisjointSet dsu(n);
+    for (const auto& edge : graph.getEdges()) dsu.unite(edge.u, edge.v);
+    for (int id = 1; id < n; id++) {
+        int up = id - cols >= 0 ? id - cols : id - 1;
+        if (dsu.unite(up, id)) addGeneratedEdge(graph, rng, config, up, id, 1.0, 1.5);
+    }
+}
+
+void generateGeometricEdges(Graph& graph, SplitMix64& rng, const GeneratorConfig& config) {
+    int n = config.numNodes;
+    int k = max(1, config.nearestNeighbours);
+
+    vector<double> xs(n), ys(n);
+    for (int id = 0; id < n; id++) {
+        xs[id] = rng.unit();
+        ys[id] = rng.unit();
+    }
+
+    // bucket points into a grid with about 2 points per cell
+    int cells = max(1, (int)sqrt(n / 2.0));
+    vector<vector<int>> grid(cells * cells);
+    auto cellOf = [&](double x) { return min(cells - 1, (int)(x * cells)); };
+    for (int id = 0; id < n; id++) grid[cellOf(ys[id]) * cells + cellOf(xs[id])].push_back(id);
+
+    double typical = 2.0 / sqrt((double)n); // rough k-NN radius, used for cost scaling
+    DisjointSet dsu(n);
+    unordered_set<uint64_t> added;
+    vector<pair<double, int>> candidates;
+
+    for (int id = 0; id < n; id++) {
+        int cx = cellOf(xs[id]);
+        int cy = cellOf(ys[id]);
+
+        // widen the ring of cells until there are enough candidates
+        for (int radius = 1; ; radius++) {
+            candidates.clear();
+            for (int gy = max(0, cy - radius); gy <= min(cells - 1, cy + radius); gy++) {
+                for (int gx = max(0, cx - radius); gx <= min(cells - 1, cx + radius); gx++) {
+                    for (int other : grid[gy * cells + gx]) {
+                        if (other == id) continue;
+                        double dx = xs[id] - xs[other];
+                        double dy = ys[id] - ys[other];
+                        candidates.push_back({dx * dx + dy * dy, other});
+                    }
+                }
+            }
+            if ((int)candidates.size() >= k || radius >= cells) break;
+        }
+
+        int take = min(k, (int)candidates.size());
+        partial_sort(candidates.begin(), candidates.begin() + take, candidates.end());
+
+        for (int j = 0; j < take; j++) {
+            int other = candidates[j].second;
+            uint64_t key = ((uint64_t)min(id, other) << 32) | (uint32_t)max(id, other);
+            if (!added.insert(key).second) continue; // already added from the other side
+            addGeneratedEdge(graph, rng, config, id, other, sqrt(candidates[j].first), typical);
+            dsu.unite(id, other);
+        }
+    }
+
+    // join whatever components are left, closest point to the depot first
+    vector<int> order(n);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) {
+        double da = (xs[a] - xs[0]) * (xs[a] - xs[0]) + (ys[a] - ys[0]) * (ys[a] - ys[0]);
+        double db = (xs[b] - xs[0]) * (xs[b] - xs[0]) + (ys[b] - ys[0]) * (ys[b] - ys[0]);
+        return da < db || (da == db && a < b);
+    });
+    for (int i = 1; i < n; i++) {
+        int a = order[i - 1];
+        int b = order[i];
+        if (dsu.unite(a, b)) {
+            double dx = xs[a] - xs[b];
+            double dy = ys[a] - ys[b];
+            addGeneratedEdge(graph, rng, config, a, b, sqrt(dx * dx + dy * dy), typical);
+        }
+    }
+}
+
+Graph generateGraph(const GeneratorConfig& config) {
+    Graph graph;
+    SplitMix64 rng(config.seed);
+
+    // windows use their own stream too, so turning them on keeps the rest
+    SplitMix64 timeRng(config.seed ^ 0x4F1BBCDCBFA53E0BULL);
+    bool timed = config.timeWindowPercent > 0 || config.maxServiceTime > 0;
+
+    graph.addNode(Node(0, 0, 0)); // depot
+    for (int id = 1; id < config.numNodes; id++) {
+        int demand = drawValue(rng, config.demand, config.minDemand, config.maxDemand);
+        int priority = drawValue(rng, config.priority, 1, config.maxPriority);
+
+        if (!timed) {
+            graph.addNode(Node(id, demand, priority));
+            continue;
+        }
+
+        double readyTime = 0.0, dueTime = INF;
+        if (timeRng.percent(config.timeWindowPercent)) {
+            int width = timeRng.range(config.minWindowWidth, config.maxWindowWidth);
+            readyTime = timeRng.range(0, max(0, config.horizon - width));
+            dueTime = readyTime + width;
+        }
+        double serviceTime = timeRng.range(config.minServiceTime, config.maxServiceTime);
+        graph.addNode(Node(id, demand, priority, readyTime, dueTime, serviceTime));
+    }
+
+    // edges use their own stream so changing node draws does not move them
+    SplitMix64 edgeRng(config.seed ^ 0xD1B54A32D192ED03ULL);
+    if (config.shape == GraphShape::GEOMETRIC) {
+        generateGeometricEdges(graph, edgeRng, config);
+    } else {
+        generateGridEdges(graph, edgeRng, config);
+    }
+
+    return graph;
+}
+
+// capacities add up to about capacitySlackPercent of the total demand
+vector<Vehicle> generateVehicles(const Graph& graph, const GeneratorConfig& config) {
+    int count = config.numVehicles;
+    if (count <= 0) count = max(1, config.numNodes / max(1, config.nodesPerVehicle));
+
+    long long totalDemand = 0;
+    for (int id = 0; id < config.numNodes; id++) {
+        const Node* node = graph.getNode(id);
+        if (node) totalDemand += node->demand;
+    }
+
+    SplitMix64 rng(config.seed ^ 0x8CB92BA72F3D8DD7ULL);
+    long long share = max(1LL, totalDemand * config.capacitySlackPercent / 100 / count);
+
+    vector<Vehicle> vehicles;
+    for (int i = 1; i <= count; i++) {
+        // +-25% around the even share
+        int capacity = (int)max(1LL, share * rng.range(75, 125) / 100);
+        vehicles.push_back(Vehicle(i, capacity));
+    }
+    return vehicles;
+}
+
+// Applies one command line option (e.g. "--nodes", "5000") to the config.
+// Returns false if the flag is not a generator option.
+bool applyGeneratorFlag(GeneratorConfig& config, const string& flag, const string& value) {
+    if (flag == "--shape") config.shape = (value == "geometric") ? GraphShape::GEOMETRIC : GraphShape::GRID;
+    else if (flag == "--nodes") config.numNodes = stoi(value);
+    else if (flag == "--seed") config.seed = stoull(value);
+    else if (flag == "--keep-street") config.keepStreetPercent = stoi(value);
+    else if (flag == "--diagonal") config.diagonalPercent = stoi(value);
+    else if (flag == "--neighbours") config.nearestNeighbours = stoi(value);
+    else if (flag == "--min-cost") config.minEdgeCost = stoi(value);
+    else if (flag == "--max-cost") config.maxEdgeCost = stoi(value);
+    else if (flag == "--min-reliability") config.minReliabilityPercent = stoi(value);
+    else if (flag == "--demand") config.demand = (value == "skewed") ? DemandDistribution::SKEWED : DemandDistribution::UNIFORM;
+    else if (flag == "--min-demand") config.minDemand = stoi(value);
+    else if (flag == "--max-demand") config.maxDemand = stoi(value);
+    else if (flag == "--priority") config.priority = (value == "skewed") ? DemandDistribution::SKEWED : DemandDistribution::UNIFORM;
+    else if (flag == "--max-priority") config.maxPriority = stoi(value);
+    else if (flag == "--time-windows") config.timeWindowPercent = stoi(value);
+    else if (flag == "--horizon") config.horizon = stoi(value);
+    else if (flag == "--min-window") config.minWindowWidth = stoi(value);
+    else if (flag == "--max-window") config.maxWindowWidth = stoi(value);
+    else if (flag == "--min-service") config.minServiceTime = stoi(value);
+    else if (flag == "--max-service") config.maxServiceTime = stoi(value);
+    else if (flag == "--vehicles") config.numVehicles = stoi(value);
+    else if (flag == "--nodes-per-vehicle") config.nodesPerVehicle = stoi(value);
+    else if (flag == "--capacity-slack") config.capacitySlackPercent = stoi(value);
+    else return false;
+    return true;
+}
+
+const char* GENERATOR_FLAGS_HELP =
+    "  --shape grid|geometric   --nodes N   --seed S\n"
+    "  --keep-street P   --diagonal P   --neighbours K\n"
+    "  --min-cost C   --max-cost C   --min-reliability P\n"
+    "  --demand uniform|skewed   --min-demand D   --max-demand D\n"
+    "  --priority uniform|skewed   --max-priority P\n"
+    "  --time-windows P   --horizon T   --min-window W   --max-window W\n"
+    "  --min-service T   --max-service T\n"
+    "  --vehicles V   --nodes-per-vehicle N   --capacity-slack P\n";
+
+#endif
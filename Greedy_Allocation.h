@@ -10,6 +10,7 @@
 #include <limits>
 #include <chrono>
 #include <iostream>
+#include <string>
 
 using namespace std;
 using namespace std::chrono;
@@ -46,22 +47,26 @@ bool helperSort(const Graph& graph, int a, int b) {
     return nodeA->priority > nodeB->priority;
 }
 
-vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehicles) {
-    
-    vector<Vehicle> V = vehicles;
-    
-    auto N = graph.getAllNodeIds();
-    
-    N.erase(std::remove(N.begin(), N.end(), 0), N.end());
+// Extension points for assignCustomers: accept() can veto giving nodeId to
+// vehicle (travel is the trip cost from the vehicle's route end), assigned()
+// is told about every assignment that is made.
+struct NoAllocationHooks {
+    bool accept(int, int, double) { return true; }
+    void assigned(int, int, double) {}
+};
+
+// Greedy assignment of the given customers onto V, highest priority first,
+// each one going to the vehicle with the cheapest trip from its current
+// route end. travelCost(from, to) returns INF when there is no route. Query
+// count and total query time (ns) are added to number and sumTime.
+template <typename TravelCost, typename Hooks = NoAllocationHooks>
+void assignCustomers(const Graph& graph, vector<Vehicle>& V, vector<int> N, TravelCost& travelCost, double& sumTime, int& number, Hooks&& hooks = Hooks()) {
 
     // lets sort by priority
     sort(N.begin(), N.end(), [&](int a, int b){
             return helperSort(graph, a, b);
     });
 
-
-    double sumTime = 0; // nanoseconds
-    int number = 0;
     for (int nodeId : N){
 
         const Node* node = graph.getNode(nodeId); 
@@ -81,32 +86,13 @@ vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehi
 
                 
                 auto start = high_resolution_clock::now();
-                auto path = astar(graph, lastNode, nodeId);
+                double totalCost = travelCost(lastNode, nodeId);
                 auto end = high_resolution_clock::now();
             
                 sumTime += duration_cast<nanoseconds>(end - start).count();
                 number++;
 
-                if (path.empty()) continue;
-
-                double totalCost = 0.0; 
-                bool ok = true;
-                
-                for (int j = 0; j + 1 < path.size() ; j++){
-
-                    double c = graph.getEdgeCost(path[j],path[j + 1]);
-
-                    if (c < 0) {
-                        ok=false; 
-                        break; 
-                    }
-
-                    totalCost += c;
-                }
-                
-                if (!ok) continue;
-
-                if (totalCost < minCost){
+                if (totalCost < minCost && hooks.accept(i, nodeId, totalCost)){
                     minCost = totalCost; 
                     bestVehicle = i; 
                 }
@@ -115,8 +101,26 @@ vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehi
 
         if (bestVehicle >= 0){
             V[bestVehicle].addNode(nodeId, node->demand);
+            hooks.assigned(bestVehicle, nodeId, minCost);
         } 
     }
+}
+
+// Greedy allocation core, travelCost and hooks as in assignCustomers;
+// queryName is only used for the timing printout.
+template <typename TravelCost, typename Hooks = NoAllocationHooks>
+vector<Vehicle> allocateVehiclesWith(const Graph& graph, const vector<Vehicle>& vehicles, TravelCost travelCost, const string& queryName, Hooks&& hooks = Hooks()) {
+    
+    vector<Vehicle> V = vehicles;
+    
+    auto N = graph.getAllNodeIds();
+    
+    N.erase(std::remove(N.begin(), N.end(), 0), N.end());
+
+    double sumTime = 0; // nanoseconds
+    int number = 0;
+
+    assignCustomers(graph, V, N, travelCost, sumTime, number, hooks);
 
     //this will just add source node so that vehicle returns back
     for (auto& v: V){
@@ -125,10 +129,41 @@ vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehi
 
     if (number > 0) {
         double avgTime = sumTime / number;
-        cout << "Average A* runtime: " << avgTime << " ns" << endl;
+        cout << "Average " << queryName << " runtime: " << avgTime << " ns" << endl;
     }
     return V;
 }
 
+// summed edge cost of a path, INF when it is empty or uses a missing edge
+double pathCost(const Graph& graph, const vector<int>& path) {
+
+    if (path.empty()) return INF;
+
+    double totalCost = 0.0; 
+    
+    for (int j = 0; j + 1 < (int)path.size() ; j++){
+
+        double c = graph.getEdgeCost(path[j],path[j + 1]);
+
+        if (c < 0) return INF;
+
+        totalCost += c;
+    }
+
+    return totalCost;
+}
+
+// cost of the A* path between two nodes, INF when there is none
+double astarTravelCost(const Graph& graph, int from, int to, QueueType queueType = QueueType::BINARY_HEAP) {
+    return pathCost(graph, astar(graph, from, to, queueType));
+}
+
+vector<Vehicle> allocateVehicles(const Graph& graph, const vector<Vehicle>& vehicles, QueueType queueType = QueueType::BINARY_HEAP) {
+
+    return allocateVehiclesWith(graph, vehicles, [&](int from, int to) {
+        return astarTravelCost(graph, from, to, queueType);
+    }, "A*");
+}
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,238 @@
+#ifndef PRIORITY_QUEUES_H
+#define PRIORITY_QUEUES_H
+
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// Min-queues used by astar(). All of them share the same small interface:
+//   push(node, key)  insert node (or lower its key if the queue supports it)
+//   pop()            remove and return the node with the smallest key
+//   empty()
+// astar() keeps its own visited set, so a queue is allowed to hand back the
+// same node more than once.
+
+enum class QueueType {
+    BINARY_HEAP,   // std::priority_queue with lazy deletion (original behaviour)
+    RADIX_HEAP,    // monotone radix heap over the bit pattern of the key
+    DIAL_BUCKETS,  // Dial's bucket queue, keys quantized to a fixed width
+    QUAD_HEAP      // indexed 4-ary heap with decrease-key
+};
+
+const char* queueTypeName(QueueType type) {
+    switch (type) {
+        case QueueType::BINARY_HEAP:  return "binary-heap";
+        case QueueType::RADIX_HEAP:   return "radix-heap";
+        case QueueType::DIAL_BUCKETS: return "dial-buckets";
+        case QueueType::QUAD_HEAP:    return "4-ary-heap";
+    }
+    return "unknown";
+}
+
+class BinaryHeapQueue {
+private:
+    priority_queue<pair<double, int>, vector<pair<double, int>>, greater<pair<double, int>>> pq;
+
+public:
+    void push(int node, double key) { pq.push({key, node}); }
+
+    int pop() {
+        int node = pq.top().second;
+        pq.pop();
+        return node;
+    }
+
+    bool empty() const { return pq.empty(); }
+};
+
+// Radix heap. Only valid for monotone extraction, i.e. every pushed key must
+// be >= the last popped key. The A* heuristic is not fully consistent, so a
+// key below the last popped one is clamped up to it (the node still carries
+// its real g value, only its position in the order changes).
+class RadixHeapQueue {
+private:
+    static const int NUM_BUCKETS = 65;
+
+    vector<pair<uint64_t, int>> buckets[NUM_BUCKETS];
+    uint64_t last = 0;
+    size_t count = 0;
+
+    // non-negative doubles keep their order when read as unsigned integers
+    static uint64_t toBits(double key) {
+        if (!(key > 0.0)) return 0;
+        uint64_t bits;
+        memcpy(&bits, &key, sizeof(bits));
+        return bits;
+    }
+
+    int bucketOf(uint64_t bits) const {
+        if (bits == last) return 0;
+        return 64 - __builtin_clzll(bits ^ last);
+    }
+
+public:
+    void push(int node, double key) {
+        uint64_t bits = max(toBits(key), last);
+        buckets[bucketOf(bits)].push_back({bits, node});
+        count++;
+    }
+
+    int pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+
+            uint64_t newLast = buckets[i][0].first;
+            for (const auto& entry : buckets[i]) newLast = min(newLast, entry.first);
+            last = newLast;
+
+            // everything in bucket i moves strictly down
+            for (const auto& entry : buckets[i]) buckets[bucketOf(entry.first)].push_back(entry);
+            buckets[i].clear();
+        }
+
+        int node = buckets[0].back().second;
+        buckets[0].pop_back();
+        count--;
+        return node;
+    }
+
+    bool empty() const { return count == 0; }
+};
+
+// Dial's bucket queue. Keys are quantized to floor(key / width) and each
+// bucket is popped last in, first out, so nodes within one width come out in
+// no particular order. That is exact only for plain Dijkstra over integral
+// costs with width = 1. A* keys are g + heuristic and the heuristic has a
+// fractional 1 - reliability term, so for astar() it is always approximate
+// (within one width). Buckets are circular; if a key lands further ahead than
+// the current span the ring is grown and rehashed.
+class DialQueue {
+private:
+    double width;
+    vector<vector<pair<long long, int>>> buckets;
+    long long cursor = 0;
+    size_t count = 0;
+
+    void grow(long long needed) {
+        size_t span = buckets.size();
+        while ((long long)span <= needed) span *= 2;
+
+        vector<vector<pair<long long, int>>> next(span);
+        for (auto& bucket : buckets) {
+            for (const auto& entry : bucket) next[entry.first % span].push_back(entry);
+        }
+        buckets.swap(next);
+    }
+
+public:
+    explicit DialQueue(double width = 1.0, size_t span = 1024)
+        : width(width > 0.0 ? width : 1.0), buckets(max<size_t>(span, 2)) {}
+
+    void push(int node, double key) {
+        long long q = (key > 0.0) ? (long long)floor(key / width) : 0;
+        q = max(q, cursor);
+
+        if (q - cursor >= (long long)buckets.size()) grow(q - cursor);
+
+        buckets[q % buckets.size()].push_back({q, node});
+        count++;
+    }
+
+    int pop() {
+        while (buckets[cursor % buckets.size()].empty()) cursor++;
+
+        auto& bucket = buckets[cursor % buckets.size()];
+        int node = bucket.back().second;
+        bucket.pop_back();
+        count--;
+        return node;
+    }
+
+    bool empty() const { return count == 0; }
+};
+
+// Indexed 4-ary heap. Each node is in the heap at most once; pushing a node
+// that is already queued lowers its key instead of adding a stale entry.
+class QuadHeapQueue {
+private:
+    vector<pair<double, int>> heap;
+    unordered_map<int, int> position;
+
+    void place(int i, const pair<double, int>& entry) {
+        heap[i] = entry;
+        position[entry.second] = i;
+    }
+
+    void siftUp(int i) {
+        pair<double, int> entry = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / 4;
+            if (!(entry < heap[parent])) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, entry);
+    }
+
+    void siftDown(int i) {
+        int n = heap.size();
+        pair<double, int> entry = heap[i];
+        while (true) {
+            int first = 4 * i + 1;
+            if (first >= n) break;
+
+            int best = first;
+            int lastChild = min(first + 4, n);
+            for (int c = first + 1; c < lastChild; c++) {
+                if (heap[c] < heap[best]) best = c;
+            }
+
+            if (!(heap[best] < entry)) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, entry);
+    }
+
+public:
+    void push(int node, double key) {
+        auto it = position.find(node);
+        if (it != position.end()) {
+            int i = it->second;
+            if (key < heap[i].first) {
+                heap[i].first = key;
+                siftUp(i);
+            }
+            return;
+        }
+
+        heap.push_back({key, node});
+        siftUp(heap.size() - 1);
+    }
+
+    int pop() {
+        int node = heap[0].second;
+        position.erase(node);
+
+        pair<double, int> lastEntry = heap.back();
+        heap.pop_back();
+
+        if (!heap.empty()) {
+            heap[0] = lastEntry;
+            siftDown(0);
+        }
+        return node;
+    }
+
+    bool empty() const { return heap.empty(); }
+};
+
+#endif
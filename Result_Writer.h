@@ -0,0 +1,350 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include "Greedy_Allocation.h"
+#include "Multi_Objective_Algorithm.h"
+#include "Binary_Reader.h"
+#include <vector>
+#include <string>
+#include <charconv>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+// Result sinks. Every sink takes the final vehicles together with the
+// RouteCost already computed for each of them (same order), so nothing here
+// calls calculateRouteCost again. Output is formatted into one in-memory
+// buffer with to_chars and handed to the OS in a single write.
+
+#pragma region Formatting
+
+void appendInt(string& out, long long value) {
+    char buf[24];
+    auto res = to_chars(buf, buf + sizeof(buf), value);
+    out.append(buf, res.ptr);
+}
+
+// same text as ostream << fixed << setprecision(2)
+void appendFixed2(string& out, double value) {
+    char buf[64];
+    auto res = to_chars(buf, buf + sizeof(buf), value, chars_format::fixed, 2);
+    out.append(buf, res.ptr);
+}
+
+void appendRoute(string& out, const vector<int>& route, const char* separator) {
+    out += '[';
+    for (int j = 0; j < (int)route.size(); j++) {
+        if (j > 0) out += separator;
+        appendInt(out, route[j]);
+    }
+    out += ']';
+}
+
+void appendRaw(string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+}
+
+// JSON string contents: quotes, backslashes and every control character are
+// escaped so a value can never break an NDJSON line
+void appendEscaped(string& out, const string& text) {
+    static const char* hex = "0123456789abcdef";
+    for (char c : text) {
+        unsigned char u = c;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (c == '\r') {
+            out += "\\r";
+        } else if (c == '\t') {
+            out += "\\t";
+        } else if (u < 0x20) {
+            out += "\\u00";
+            out += hex[u >> 4];
+            out += hex[u & 0xf];
+        } else {
+            out += c;
+        }
+    }
+}
+
+template <typename T>
+void appendPod(string& out, T value) {
+    appendRaw(out, &value, sizeof(T));
+}
+
+// pretty JSON identical to the original saveResultsToJSON layout
+string formatResultsJSON(const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) {
+    string out;
+    out.reserve(128 + vehicles.size() * 160);
+
+    out += "{\n  \"routes\": {\n";
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        out += "    \"";
+        appendInt(out, vehicles[i].id);
+        out += "\": ";
+        appendRoute(out, vehicles[i].route, ", ");
+        if (i < (int)vehicles.size() - 1) out += ',';
+        out += '\n';
+    }
+
+    out += "  },\n  \"costs\": {\n";
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        const RouteCost& cost = costs[i];
+        out += "    \"";
+        appendInt(out, vehicles[i].id);
+        out += "\": {\n      \"total_time\": ";
+        appendFixed2(out, cost.totalTime);
+        out += ",\n      \"reliability_penalty\": ";
+        appendFixed2(out, cost.reliabilityPenalty);
+        out += ",\n      \"idle_time\": ";
+        appendFixed2(out, cost.idleTime);
+        out += ",\n      \"final_score\": ";
+        appendFixed2(out, cost.finalScore);
+        out += "\n    }";
+        if (i < (int)vehicles.size() - 1) out += ',';
+        out += '\n';
+    }
+
+    out += "  }\n}\n";
+    return out;
+}
+
+// single line JSON, used for NDJSON streams
+string formatResultsNDJSON(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) {
+    string out;
+    out.reserve(64 + scenario.size() + vehicles.size() * 128);
+
+    out += "{\"scenario\":\"";
+    appendEscaped(out, scenario);
+    out += "\",\"routes\":{";
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        if (i > 0) out += ',';
+        out += '"';
+        appendInt(out, vehicles[i].id);
+        out += "\":";
+        appendRoute(out, vehicles[i].route, ",");
+    }
+
+    out += "},\"costs\":{";
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        const RouteCost& cost = costs[i];
+        if (i > 0) out += ',';
+        out += '"';
+        appendInt(out, vehicles[i].id);
+        out += "\":{\"total_time\":";
+        appendFixed2(out, cost.totalTime);
+        out += ",\"reliability_penalty\":";
+        appendFixed2(out, cost.reliabilityPenalty);
+        out += ",\"idle_time\":";
+        appendFixed2(out, cost.idleTime);
+        out += ",\"final_score\":";
+        appendFixed2(out, cost.finalScore);
+        out += '}';
+    }
+
+    out += "}}\n";
+    return out;
+}
+
+// compact binary record, native byte order:
+//   u32 nameLen, name bytes, u32 vehicleCount, then per vehicle
+//   i32 id, i32 capacity, i32 currentLoad, u32 routeLen, i32 route[routeLen],
+//   f64 totalTime, f64 reliabilityPenalty, f64 idleTime, f64 finalScore
+string formatResultsBinary(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) {
+    string out;
+    out.reserve(8 + scenario.size() + vehicles.size() * 64);
+
+    appendPod<uint32_t>(out, scenario.size());
+    appendRaw(out, scenario.data(), scenario.size());
+    appendPod<uint32_t>(out, vehicles.size());
+
+    for (int i = 0; i < (int)vehicles.size(); i++) {
+        const Vehicle& vehicle = vehicles[i];
+        appendPod<int32_t>(out, vehicle.id);
+        appendPod<int32_t>(out, vehicle.capacity);
+        appendPod<int32_t>(out, vehicle.currentLoad);
+        appendPod<uint32_t>(out, vehicle.route.size());
+        for (int nodeId : vehicle.route) appendPod<int32_t>(out, nodeId);
+
+        appendPod<double>(out, costs[i].totalTime);
+        appendPod<double>(out, costs[i].reliabilityPenalty);
+        appendPod<double>(out, costs[i].idleTime);
+        appendPod<double>(out, costs[i].finalScore);
+    }
+    return out;
+}
+
+#pragma endregion
+
+// writes the whole buffer with one unbuffered fwrite (one write syscall)
+bool writeWholeFile(const string& filename, const string& data) {
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        cerr << "Cannot create file: " << filename << endl;
+        return false;
+    }
+    setvbuf(file, nullptr, _IONBF, 0);
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
+
+class ResultSink {
+public:
+    virtual ~ResultSink() = default;
+
+    // costs[i] must belong to vehicles[i]
+    virtual bool write(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) = 0;
+
+    virtual bool flush() { return true; }
+};
+
+// one pretty JSON file per scenario: <directory>/<scenario>.json
+class JsonDirectorySink : public ResultSink {
+private:
+    string directory;
+
+public:
+    explicit JsonDirectorySink(const string& directory) : directory(directory) {}
+
+    bool write(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) override {
+        return writeWholeFile(directory + "/" + scenario + ".json", formatResultsJSON(vehicles, costs));
+    }
+};
+
+// Base for sinks that keep a single file open across all scenarios. Records
+// are collected in memory and written out once the buffer passes
+// flushThreshold bytes (and on flush / destruction).
+class StreamResultSink : public ResultSink {
+private:
+    FILE* file = nullptr;
+    string buffer;
+    size_t flushThreshold;
+
+protected:
+    // false when a flush this triggered failed to write
+    bool append(const string& record) {
+        buffer += record;
+        if (buffer.size() >= flushThreshold) return flush();
+        return true;
+    }
+
+public:
+    StreamResultSink(const string& filename, size_t flushThreshold)
+        : flushThreshold(flushThreshold) {
+        file = fopen(filename.c_str(), "wb");
+        if (!file) {
+            cerr << "Cannot create file: " << filename << endl;
+            return;
+        }
+        setvbuf(file, nullptr, _IONBF, 0);
+        buffer.reserve(flushThreshold);
+    }
+
+    // call flush() first to find out whether the tail of the stream was written
+    ~StreamResultSink() override {
+        if (!buffer.empty() && !flush()) cerr << "Failed to write buffered results" << endl;
+        if (file) fclose(file);
+    }
+
+    StreamResultSink(const StreamResultSink&) = delete;
+    StreamResultSink& operator=(const StreamResultSink&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    bool flush() override {
+        if (!file) return false;
+        bool ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        buffer.clear();
+        return ok;
+    }
+};
+
+// newline delimited JSON, one scenario per line
+class NdjsonResultSink : public StreamResultSink {
+public:
+    explicit NdjsonResultSink(const string& filename, size_t flushThreshold = 1 << 20)
+        : StreamResultSink(filename, flushThreshold) {}
+
+    bool write(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) override {
+        if (!isOpen()) return false;
+        return append(formatResultsNDJSON(scenario, vehicles, costs));
+    }
+};
+
+// binary stream: "DRRB" magic, u32 version, then formatResultsBinary records
+class BinaryResultSink : public StreamResultSink {
+public:
+    static const uint32_t VERSION = 1;
+
+    explicit BinaryResultSink(const string& filename, size_t flushThreshold = 1 << 20)
+        : StreamResultSink(filename, flushThreshold) {
+        string header = "DRRB";
+        appendPod<uint32_t>(header, VERSION);
+        append(header);
+    }
+
+    bool write(const string& scenario, const vector<Vehicle>& vehicles, const vector<RouteCost>& costs) override {
+        if (!isOpen()) return false;
+        return append(formatResultsBinary(scenario, vehicles, costs));
+    }
+};
+
+struct ResultRecord {
+    string scenario;
+    vector<Vehicle> vehicles;
+    vector<RouteCost> costs;
+};
+
+// Load every record of a BinaryResultSink file
+vector<ResultRecord> loadResultsFromBinary(const string& filename) {
+    BinaryReader in(filename, "results");
+    in.header("DRRB", BinaryResultSink::VERSION, BinaryResultSink::VERSION);
+
+    // per vehicle: i32 id, capacity, currentLoad, u32 route length, 4 f64 costs
+    const size_t vehicleSize = 4 * sizeof(int32_t) + 4 * sizeof(double);
+
+    vector<ResultRecord> records;
+    while (!in.done()) {
+        ResultRecord record;
+
+        uint32_t nameLen = in.get<uint32_t>();
+        in.expect(nameLen, 1);
+        record.scenario.resize(nameLen);
+        in.read(&record.scenario[0], nameLen);
+
+        uint32_t numVehicles = in.get<uint32_t>();
+        in.expect(numVehicles, vehicleSize);
+
+        for (uint32_t i = 0; i < numVehicles; i++) {
+            Vehicle vehicle;
+            vehicle.id = in.get<int32_t>();
+            vehicle.capacity = in.get<int32_t>();
+            vehicle.currentLoad = in.get<int32_t>();
+
+            uint32_t routeLen = in.get<uint32_t>();
+            in.expect(routeLen, sizeof(int32_t));
+            vehicle.route.resize(routeLen);
+            for (uint32_t j = 0; j < routeLen; j++) vehicle.route[j] = in.get<int32_t>();
+
+            RouteCost cost;
+            cost.totalTime = in.get<double>();
+            cost.reliabilityPenalty = in.get<double>();
+            cost.idleTime = in.get<double>();
+            cost.finalScore = in.get<double>();
+
+            record.vehicles.push_back(vehicle);
+            record.costs.push_back(cost);
+        }
+        records.push_back(record);
+    }
+    return records;
+}
+
+#endif
@@ -0,0 +1,305 @@
+#ifndef SOLVER_SERVICE_H
+#define SOLVER_SERVICE_H
+
+#include "Graph.h"
+#include "Greedy_Allocation.h"
+#include "Two_Opt_Algorithm.h"
+#include "Multi_Objective_Algorithm.h"
+#include "Contraction_Hierarchy.h"
+#include "Cluster_Allocation.h"
+#include "Time_Windows.h"
+#include "Result_Writer.h"
+#include "File_Handling.h"
+#include <vector>
+#include <string>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <stdexcept>
+
+using namespace std;
+
+// Long-lived solver. The graph, its contraction hierarchy and its dense copy
+// for clustering are built once and shared read-only; solve requests are
+// queued and handed to a pool of workers. A worker takes its share of the
+// queue (queued jobs over workers not busy, at most batchSize), so a burst
+// spreads over the whole pool and only a backlog deeper than the pool is
+// taken in batches. Each worker owns one CHQuery, so all travel costs are
+// hierarchy lookups on warm memory.
+//
+// Requests and responses are single JSON lines (NDJSON):
+//   {"id": "r1", "mode": "greedy", "two_opt": true,
+//    "vehicles": [{"id": 1, "capacity": 20}, ...]}
+// mode is greedy (default), cluster or timed; cluster routes always get
+// twoOpt. The response is the formatResultsNDJSON line with the request id
+// as "scenario", or
+//   {"scenario": "r1", "error": "..."}
+// Keys are looked up at the top level only, so the "id" of a vehicle is
+// never mistaken for the request id whatever the key order.
+
+enum class SolveMode {
+    GREEDY,
+    CLUSTER,
+    TIMED
+};
+
+struct SolveRequest {
+    string id;
+    SolveMode mode = SolveMode::GREEDY;
+    bool twoOpt = true;
+    vector<Vehicle> vehicles;
+};
+
+// value of a top level "key": "value" pair, or fallback when absent. Keys
+// inside nested objects and arrays (the vehicles) are skipped.
+string extractJsonString(const string& line, const string& key, const string& fallback = "") {
+    int depth = 0;
+    size_t i = 0;
+
+    // end of the string literal starting at the quote at pos
+    auto stringEnd = [&](size_t pos) {
+        for (size_t j = pos + 1; j < line.size(); j++) {
+            if (line[j] == '\\') j++;
+            else if (line[j] == '"') return j;
+        }
+        return string::npos;
+    };
+
+    while (i < line.size()) {
+        char c = line[i];
+
+        if (c == '{' || c == '[') {
+            depth++;
+            i++;
+        } else if (c == '}' || c == ']') {
+            depth--;
+            i++;
+        } else if (c == '"') {
+            size_t close = stringEnd(i);
+            if (close == string::npos) return fallback;
+
+            size_t colon = line.find_first_not_of(" \t", close + 1);
+            bool isKey = depth == 1 && colon != string::npos && line[colon] == ':';
+
+            if (!isKey || line.compare(i + 1, close - i - 1, key) != 0) {
+                i = close + 1;
+                continue;
+            }
+
+            size_t open = line.find_first_not_of(" \t", colon + 1);
+            if (open == string::npos) return fallback;
+
+            // numbers are accepted as ids too
+            if (line[open] != '"') {
+                size_t end = line.find_first_of(",}", open);
+                string raw = line.substr(open, end == string::npos ? string::npos : end - open);
+                while (!raw.empty() && (raw.back() == ' ' || raw.back() == '\t')) raw.pop_back();
+                return raw;
+            }
+
+            size_t valueEnd = stringEnd(open);
+            if (valueEnd == string::npos) return fallback;
+
+            string value;
+            for (size_t j = open + 1; j < valueEnd; j++) {
+                if (line[j] != '\\' || j + 1 >= valueEnd) {
+                    value += line[j];
+                    continue;
+                }
+                char e = line[++j];
+                value += (e == 'n') ? '\n' : (e == 'r') ? '\r' : (e == 't') ? '\t' : e;
+            }
+            return value;
+        } else {
+            i++;
+        }
+    }
+    return fallback;
+}
+
+bool extractJsonBool(const string& line, const string& key, bool fallback) {
+    string value = extractJsonString(line, key);
+    if (value == "true") return true;
+    if (value == "false") return false;
+    return fallback;
+}
+
+SolveRequest parseSolveRequest(const string& line) {
+    SolveRequest request;
+    request.id = extractJsonString(line, "id");
+    request.twoOpt = extractJsonBool(line, "two_opt", true);
+
+    string mode = extractJsonString(line, "mode", "greedy");
+    if (mode == "greedy") request.mode = SolveMode::GREEDY;
+    else if (mode == "cluster") request.mode = SolveMode::CLUSTER;
+    else if (mode == "timed") request.mode = SolveMode::TIMED;
+    else throw runtime_error("unknown mode: " + mode);
+
+    request.vehicles = parseVehiclesFromJSON(line);
+    if (request.vehicles.empty()) throw runtime_error("request has no vehicles");
+
+    return request;
+}
+
+string formatErrorNDJSON(const string& id, const string& message) {
+    string out = "{\"scenario\":\"";
+    appendEscaped(out, id);
+    out += "\",\"error\":\"";
+    appendEscaped(out, message);
+    out += "\"}\n";
+    return out;
+}
+
+class SolverService {
+private:
+    struct Job {
+        string line;
+        function<void(const string&)> reply;
+    };
+
+    const Graph& graph;
+    const ContractionHierarchy& ch;
+    DenseGraph dense;
+    vector<int> customers;
+    int batchSize;
+
+    deque<Job> jobs;
+    mutex jobsMutex;
+    condition_variable jobsReady;
+    int poolSize = 0;
+    int busy = 0;                    // workers running a batch
+    bool stopping = false;
+    vector<thread> workers;
+
+    string solve(const string& line, CHQuery& query) {
+        SolveRequest request;
+        try {
+            request = parseSolveRequest(line);
+        } catch (const exception& e) {
+            return formatErrorNDJSON(extractJsonString(line, "id"), e.what());
+        }
+
+        auto travel = [&query](int from, int to) {
+            return query.distance(from, to);
+        };
+
+        vector<Vehicle> V = request.vehicles;
+        double sumTime = 0;
+        int number = 0;
+
+        if (request.mode == SolveMode::CLUSTER) {
+            ClusterOptions options;
+            options.threads = 1; // the pool already runs one request per worker
+            V = allocateVehiclesClusteredWith(graph, dense, V, options, [&]() { return travel; }, "CH query");
+        } else {
+            if (request.mode == SolveMode::TIMED) {
+                TimeWindowHooks<decltype(travel)> hooks(graph, V, travel);
+                assignCustomers(graph, V, customers, travel, sumTime, number, hooks);
+            } else {
+                assignCustomers(graph, V, customers, travel, sumTime, number);
+            }
+
+            for (auto& vehicle : V) {
+                vehicle.route.push_back(0);
+                if (!request.twoOpt) continue;
+                vehicle.route = (request.mode == SolveMode::TIMED) ? twoOptTimed(graph, vehicle.route, travel)
+                                                                   : twoOpt(graph, vehicle.route);
+            }
+        }
+
+        vector<RouteCost> costs;
+        costs.reserve(V.size());
+        for (const auto& vehicle : V) {
+            if (request.mode == SolveMode::TIMED) {
+                costs.push_back(calculateTimedRouteCost(graph, vehicle.route, travel));
+            } else {
+                costs.push_back(calculateRouteCost(graph, vehicle.route, vehicle.capacity, vehicle.currentLoad));
+            }
+        }
+
+        return formatResultsNDJSON(request.id, V, costs);
+    }
+
+    void workerLoop() {
+        CHQuery query(ch);
+        vector<Job> batch;
+
+        while (true) {
+            {
+                unique_lock<mutex> lock(jobsMutex);
+                jobsReady.wait(lock, [&]() { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return; // stopping and drained
+
+                // this worker's share of the queue, leaving the rest to the
+                // workers that are free; a backlog deeper than the pool goes
+                // in batches so busy periods cost one lock per batch
+                int available = max(1, poolSize - busy);
+                int share = ((int)jobs.size() + available - 1) / available;
+                int take = max(1, min(share, batchSize));
+                for (int i = 0; i < take; i++) {
+                    batch.push_back(move(jobs.front()));
+                    jobs.pop_front();
+                }
+                busy++;
+                if (!jobs.empty()) jobsReady.notify_one();
+            }
+
+            for (auto& job : batch) {
+                string response;
+                try {
+                    response = solve(job.line, query);
+                } catch (const exception& e) {
+                    response = formatErrorNDJSON(extractJsonString(job.line, "id"), e.what());
+                }
+                job.reply(response);
+            }
+            batch.clear();
+
+            lock_guard<mutex> lock(jobsMutex);
+            busy--;
+        }
+    }
+
+public:
+    SolverService(const Graph& graph, const ContractionHierarchy& ch, int numWorkers = 0, int batchSize = 8)
+        : graph(graph), ch(ch), dense(graph), batchSize(max(1, batchSize)) {
+
+        customers = graph.getAllNodeIds();
+        customers.erase(std::remove(customers.begin(), customers.end(), 0), customers.end());
+
+        if (numWorkers <= 0) numWorkers = max(1u, thread::hardware_concurrency());
+        poolSize = numWorkers;
+        for (int i = 0; i < numWorkers; i++) workers.emplace_back(&SolverService::workerLoop, this);
+    }
+
+    ~SolverService() { shutdown(); }
+
+    SolverService(const SolverService&) = delete;
+    SolverService& operator=(const SolverService&) = delete;
+
+    // queue one request line; reply is called from a worker thread with the response line
+    void submit(const string& line, function<void(const string&)> reply) {
+        {
+            lock_guard<mutex> lock(jobsMutex);
+            jobs.push_back({line, move(reply)});
+        }
+        jobsReady.notify_one();
+    }
+
+    // finishes everything already queued, then stops the workers
+    void shutdown() {
+        {
+            lock_guard<mutex> lock(jobsMutex);
+            stopping = true;
+        }
+        jobsReady.notify_all();
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        workers.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef TAIL_DISTANCES_H
+#define TAIL_DISTANCES_H
+
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Priority_Queues.h"
+#include "Greedy_Allocation.h"
+#include "Dense_Graph.h"
+#include <vector>
+#include <unordered_map>
+#include <string>
+
+using namespace std;
+
+// Memoized travel costs for the greedy allocation.
+//
+// A vehicle's route end only moves when it is given a customer, yet the
+// A* allocation searches again from that same end for every customer it
+// considers. Here each route end that is asked about owns one Dijkstra tree
+// (within the budget below) that is grown only as far as the costs asked for
+// so far (a paused search that resumes when a node beyond its frontier is
+// asked for), so after the first few customers most queries are an array
+// lookup. When a vehicle is assigned a customer only that vehicle's tree is
+// dropped; vehicles sharing an end (all of them start at the depot) share
+// one tree.
+//
+// Costs are exact shortest path costs, like the CH query; A* can return a
+// longer path since its heuristic is not admissible, so routes may differ.
+//
+// A tree is 13 bytes per graph node (4 stamp + 1 settled + 8 distance) and
+// on large graphs each one ends up covering most of the graph, so V route
+// ends would cost V x N. Trees are therefore only handed out up to
+// memoryBudgetMB; route ends that find no free tree run a one-off search in
+// a shared scratch tree instead (the old per query cost, without A*).
+// A tree freed by an assignment goes to the next route end that asks.
+
+struct TailTreeOptions {
+    size_t memoryBudgetMB = 256;    // all trees together, scratch tree included
+};
+
+template <typename Queue = BinaryHeapQueue>
+class TailDistanceTrees {
+private:
+    struct Tree {
+        int source = -1;
+        int stamp = 0;               // entries are only valid where seen == stamp
+        vector<int> seen;
+        vector<char> settled;
+        vector<double> dist;
+        Queue pq;
+    };
+
+    DenseGraph dense;
+
+    int maxTrees;                    // resident trees the budget allows
+    vector<Tree> trees;
+    Tree scratch;
+    unordered_map<int, int> treeOf;  // route end -> tree
+    unordered_map<int, int> endCount; // vehicles whose route ends at a node
+    vector<int> idle;                // trees whose source nobody ends at any more
+    vector<int> tailOf;              // route end per vehicle
+
+    bool inUse(int t) const {
+        auto it = endCount.find(trees[t].source);
+        return it != endCount.end() && it->second > 0;
+    }
+
+    void reset(Tree& tree, int source) {
+        if (tree.seen.empty()) {
+            tree.seen.assign(dense.size(), 0);
+            tree.settled.assign(dense.size(), 0);
+            tree.dist.assign(dense.size(), INF);
+        }
+        tree.source = source;
+        tree.stamp++;
+        tree.pq = Queue();
+
+        int s = dense.indexOfNode(source);
+        tree.seen[s] = tree.stamp;
+        tree.settled[s] = 0;
+        tree.dist[s] = 0.0;
+        tree.pq.push(s, 0.0);
+    }
+
+    // resident tree for a route end, the scratch tree when the budget is used up
+    Tree& treeFor(int source) {
+        auto it = treeOf.find(source);
+        if (it != treeOf.end()) return trees[it->second];
+
+        int t = -1;
+        while (!idle.empty()) {
+            int candidate = idle.back();
+            idle.pop_back();
+            if (!inUse(candidate)) {
+                t = candidate;
+                break;
+            }
+        }
+
+        if (t < 0 && (int)trees.size() < maxTrees) {
+            t = trees.size();
+            trees.emplace_back();
+        }
+
+        if (t < 0) {
+            if (scratch.source != source) reset(scratch, source);
+            return scratch;
+        }
+
+        if (trees[t].source != -1) treeOf.erase(trees[t].source);
+        reset(trees[t], source);
+        treeOf[source] = t;
+        if (!inUse(t)) idle.push_back(t); // not a route end, first to be reused
+        return trees[t];
+    }
+
+    void detach(int source) {
+        if (--endCount[source] > 0) return;
+        auto it = treeOf.find(source);
+        if (it != treeOf.end()) idle.push_back(it->second);
+    }
+
+    // resumes the paused search until target is settled or the tree is complete
+    double grow(Tree& tree, int targetIndex) {
+        while (!tree.pq.empty()) {
+            int u = tree.pq.pop();
+            if (tree.settled[u]) continue;
+            tree.settled[u] = 1;
+
+            for (int e = dense.offset[u]; e < dense.offset[u + 1]; e++) {
+                int v = dense.target[e];
+                double d = tree.dist[u] + dense.cost[e];
+
+                if (tree.seen[v] != tree.stamp) {
+                    tree.seen[v] = tree.stamp;
+                    tree.settled[v] = 0;
+                    tree.dist[v] = INF;
+                }
+                if (d < tree.dist[v]) {
+                    tree.dist[v] = d;
+                    tree.pq.push(v, d);
+                }
+            }
+
+            if (u == targetIndex) return tree.dist[u];
+        }
+        return INF;
+    }
+
+public:
+    TailDistanceTrees(const Graph& graph, const vector<Vehicle>& vehicles, const TailTreeOptions& options = TailTreeOptions())
+        : dense(graph) {
+
+        size_t treeBytes = max<size_t>(1, dense.size() * (sizeof(int) + sizeof(char) + sizeof(double)));
+        maxTrees = (int)min<size_t>(options.memoryBudgetMB * (1 << 20) / treeBytes, vehicles.size() + 1);
+        maxTrees = max(0, maxTrees - 1); // the scratch tree comes out of the same budget
+
+        for (const auto& vehicle : vehicles) {
+            int tail = vehicle.route.empty() ? 0 : vehicle.route.back();
+            tailOf.push_back(tail);
+            endCount[tail]++;
+        }
+    }
+
+    // shortest path cost, INF when there is none
+    double distance(int from, int to) {
+        int t = dense.indexOfNode(to);
+        if (dense.indexOfNode(from) < 0 || t < 0) return INF;
+
+        Tree& tree = treeFor(from);
+        if (tree.seen[t] == tree.stamp && tree.settled[t]) return tree.dist[t];
+        return grow(tree, t);
+    }
+
+    int numTrees() const { return trees.size(); }
+
+    // assignCustomers hooks
+    bool accept(int, int, double) { return true; }
+
+    void assigned(int vehicle, int nodeId, double) {
+        detach(tailOf[vehicle]);
+        tailOf[vehicle] = nodeId;
+        endCount[nodeId]++;
+    }
+};
+
+template <typename Queue>
+vector<Vehicle> allocateVehiclesMemoizedWith(const Graph& graph, const vector<Vehicle>& vehicles, const TailTreeOptions& options) {
+    TailDistanceTrees<Queue> trees(graph, vehicles, options);
+
+    return allocateVehiclesWith(graph, vehicles, [&](int from, int to) {
+        return trees.distance(from, to);
+    }, "tail tree", trees);
+}
+
+// greedy allocation reading travel costs from the per vehicle trees
+vector<Vehicle> allocateVehiclesMemoized(const Graph& graph, const vector<Vehicle>& vehicles, QueueType queueType = QueueType::BINARY_HEAP, const TailTreeOptions& options = TailTreeOptions()) {
+
+    switch (queueType) {
+        case QueueType::RADIX_HEAP:   return allocateVehiclesMemoizedWith<RadixHeapQueue>(graph, vehicles, options);
+        case QueueType::DIAL_BUCKETS: return allocateVehiclesMemoizedWith<DialQueue>(graph, vehicles, options);
+        case QueueType::QUAD_HEAP:    return allocateVehiclesMemoizedWith<QuadHeapQueue>(graph, vehicles, options);
+        default:                      return allocateVehiclesMemoizedWith<BinaryHeapQueue>(graph, vehicles, options);
+    }
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef TIME_WINDOWS_H
+#define TIME_WINDOWS_H
+
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Greedy_Allocation.h"
+#include "Multi_Objective_Algorithm.h"
+#include "Two_Opt_Algorithm.h"
+#include "Contraction_Hierarchy.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <string>
+
+using namespace std;
+
+// Time windows and service times.
+//
+// Every stop has a window [readyTime, dueTime] in which service must start
+// and a serviceTime spent there; arriving early means waiting. Travel time
+// between two stops is the shortest path cost between them (routes only list
+// the stops, not the roads in between).
+//
+// Feasibility uses route segments that summarise any run of consecutive
+// stops in four numbers (Vidal et al. concatenation): total duration,
+// time warp (how late it would run), and the earliest / latest time the
+// segment can start. Two segments concatenate in O(1), so with prefix
+// (forward) and suffix (backward) segments of a route, inserting a stop or
+// reversing a piece of it is checked in constant time.
+
+const double TIME_EPS = 1e-9;
+
+struct TimeSegment {
+    double duration;  // service + travel + waiting inside the segment
+    double timeWarp;  // total lateness, 0 for a feasible segment
+    double earliest;  // earliest start of the first service
+    double latest;    // latest start of the first service without extra warp
+
+    TimeSegment() : duration(0.0), timeWarp(0.0), earliest(0.0), latest(INF) {}
+
+    explicit TimeSegment(const Node& node)
+        : duration(node.serviceTime), timeWarp(0.0), earliest(node.readyTime), latest(node.dueTime) {}
+
+    bool feasible() const { return timeWarp <= TIME_EPS; }
+};
+
+// segment a followed by segment b, travel is the time from a's last stop to b's first
+TimeSegment concat(const TimeSegment& a, const TimeSegment& b, double travel) {
+    TimeSegment out;
+
+    if (travel == INF) {
+        out.duration = INF;
+        out.timeWarp = INF;
+        out.earliest = a.earliest;
+        out.latest = -INF;
+        return out;
+    }
+
+    double delta = a.duration - a.timeWarp + travel;
+    double wait = max(b.earliest - delta - a.latest, 0.0);
+    double warp = (b.latest == INF) ? 0.0 : max(a.earliest + delta - b.latest, 0.0);
+
+    out.duration = a.duration + b.duration + travel + wait;
+    out.timeWarp = a.timeWarp + b.timeWarp + warp;
+    out.earliest = max(b.earliest - delta, a.earliest) - wait;
+    out.latest = (b.latest == INF ? a.latest : min(b.latest - delta, a.latest)) + warp;
+    return out;
+}
+
+TimeSegment segmentOf(const Graph& graph, int nodeId) {
+    const Node* node = graph.getNode(nodeId);
+    return node ? TimeSegment(*node) : TimeSegment();
+}
+
+// Prefix and suffix segments of one route. prefix[i] covers route[0..i],
+// suffix[i] covers route[i..end], leg[i] is the travel time route[i] -> route[i + 1].
+class RouteSchedule {
+private:
+    vector<int> route;
+    vector<double> leg;
+    vector<TimeSegment> prefix;
+    vector<TimeSegment> suffix;
+
+public:
+    RouteSchedule() = default;
+
+    template <typename TravelTime>
+    RouteSchedule(const Graph& graph, const vector<int>& route, TravelTime& travelTime) {
+        rebuild(graph, route, travelTime);
+    }
+
+    template <typename TravelTime>
+    void rebuild(const Graph& graph, const vector<int>& newRoute, TravelTime& travelTime) {
+        route = newRoute;
+        int n = route.size();
+
+        leg.assign(max(0, n - 1), 0.0);
+        for (int i = 0; i + 1 < n; i++) leg[i] = travelTime(route[i], route[i + 1]);
+
+        prefix.assign(n, TimeSegment());
+        suffix.assign(n, TimeSegment());
+        if (n == 0) return;
+
+        prefix[0] = segmentOf(graph, route[0]);
+        for (int i = 1; i < n; i++) prefix[i] = concat(prefix[i - 1], segmentOf(graph, route[i]), leg[i - 1]);
+
+        suffix[n - 1] = segmentOf(graph, route[n - 1]);
+        for (int i = n - 2; i >= 0; i--) suffix[i] = concat(segmentOf(graph, route[i]), suffix[i + 1], leg[i]);
+    }
+
+    int size() const { return route.size(); }
+    const TimeSegment& prefixAt(int i) const { return prefix[i]; }
+    const TimeSegment& suffixAt(int i) const { return suffix[i]; }
+    double legAt(int i) const { return leg[i]; }
+
+    bool feasible() const { return route.empty() || prefix.back().feasible(); }
+
+    // can nodeId be served between route[pos - 1] and route[pos]?
+    bool canInsert(const Graph& graph, int pos, int nodeId, double travelIn, double travelOut) const {
+        TimeSegment s = concat(prefix[pos - 1], segmentOf(graph, nodeId), travelIn);
+        if (!s.feasible()) return false;
+        if (pos >= (int)route.size()) return true;
+        return concat(s, suffix[pos], travelOut).feasible();
+    }
+};
+
+// arrival, service start, waiting and departure at every stop, leaving the
+// first stop at time 0 and starting each service as early as its window allows
+struct StopTimes {
+    double arrival;
+    double start;
+    double wait;
+    double departure;
+};
+
+template <typename TravelTime>
+vector<StopTimes> scheduleRoute(const Graph& graph, const vector<int>& route, TravelTime& travelTime) {
+    vector<StopTimes> times(route.size());
+    double clock = 0.0;
+
+    for (int i = 0; i < (int)route.size(); i++) {
+        const Node* node = graph.getNode(route[i]);
+        double ready = node ? node->readyTime : 0.0;
+        double service = node ? node->serviceTime : 0.0;
+
+        if (i > 0) clock += travelTime(route[i - 1], route[i]);
+
+        times[i].arrival = clock;
+        times[i].start = max(clock, ready);
+        times[i].wait = times[i].start - clock;
+        times[i].departure = times[i].start + service;
+        clock = times[i].departure;
+    }
+    return times;
+}
+
+// Multi objective cost on the real schedule: totalTime is sum(priority *
+// service start) and idleTime the total waiting time, instead of the
+// cumulative edge cost / unused capacity used by calculateRouteCost.
+template <typename TravelTime>
+RouteCost calculateTimedRouteCost(const Graph& graph, const vector<int>& route, TravelTime& travelTime) {
+    RouteCost cost;
+    if (route.size() < 2) return cost;
+
+    vector<StopTimes> times = scheduleRoute(graph, route, travelTime);
+
+    for (int i = 1; i < (int)route.size(); i++) {
+        const Node* node = graph.getNode(route[i]);
+        if (node) cost.totalTime += node->priority * times[i].start;
+
+        double r = graph.getEdgeReliability(route[i - 1], route[i]);
+        if (graph.getEdgeCost(route[i - 1], route[i]) >= 0) cost.reliabilityPenalty += 1.0 - r;
+
+        cost.idleTime += times[i].wait;
+    }
+
+    cost.finalScore = (ALPHA * cost.totalTime) + (BETA * cost.reliabilityPenalty) + (GAMMA * cost.idleTime);
+    return cost;
+}
+
+// assignCustomers hooks: a customer is only given to a vehicle if the
+// vehicle can still reach it inside its window and get back to the depot in
+// time. Each vehicle keeps the segment of its route so far, so the check is
+// O(1) plus one travel query back to the depot per customer.
+template <typename TravelTime>
+class TimeWindowHooks {
+private:
+    const Graph& graph;
+    TravelTime& travelTime;
+    vector<TimeSegment> tail;
+    TimeSegment depot;
+    unordered_map<int, double> backToDepot;
+
+    double returnTime(int nodeId) {
+        auto it = backToDepot.find(nodeId);
+        if (it != backToDepot.end()) return it->second;
+        double t = travelTime(nodeId, 0);
+        backToDepot[nodeId] = t;
+        return t;
+    }
+
+public:
+    TimeWindowHooks(const Graph& graph, const vector<Vehicle>& vehicles, TravelTime& travelTime)
+        : graph(graph), travelTime(travelTime), depot(segmentOf(graph, 0)) {
+        for (const auto& vehicle : vehicles) {
+            RouteSchedule schedule(graph, vehicle.route, travelTime);
+            tail.push_back(schedule.size() > 0 ? schedule.prefixAt(schedule.size() - 1) : TimeSegment());
+        }
+    }
+
+    bool accept(int vehicle, int nodeId, double travel) {
+        TimeSegment s = concat(tail[vehicle], segmentOf(graph, nodeId), travel);
+        if (!s.feasible()) return false;
+        return concat(s, depot, returnTime(nodeId)).feasible();
+    }
+
+    void assigned(int vehicle, int nodeId, double travel) {
+        tail[vehicle] = concat(tail[vehicle], segmentOf(graph, nodeId), travel);
+    }
+};
+
+template <typename TravelTime>
+vector<Vehicle> allocateVehiclesTimedWith(const Graph& graph, const vector<Vehicle>& vehicles, TravelTime travelTime, const string& queryName) {
+
+    TimeWindowHooks<TravelTime> hooks(graph, vehicles, travelTime);
+    return allocateVehiclesWith(graph, vehicles, [&](int from, int to) {
+        return travelTime(from, to);
+    }, queryName, hooks);
+}
+
+vector<Vehicle> allocateVehiclesTimed(const Graph& graph, const vector<Vehicle>& vehicles, QueueType queueType = QueueType::BINARY_HEAP) {
+
+    return allocateVehiclesTimedWith(graph, vehicles, [&](int from, int to) {
+        return astarTravelCost(graph, from, to, queueType);
+    }, "A*");
+}
+
+vector<Vehicle> allocateVehiclesTimed(const Graph& graph, const vector<Vehicle>& vehicles, const ContractionHierarchy& ch) {
+    CHQuery query(ch);
+
+    return allocateVehiclesTimedWith(graph, vehicles, [&](int from, int to) {
+        return query.distance(from, to);
+    }, "CH query");
+}
+
+// twoOpt that keeps the route inside its time windows. Moves are chosen by
+// the same gain rule as twoOpt; a move is only taken if
+// prefix[i - 1] + reversed(i..j) + suffix[j + 1] has no time warp, where the
+// reversed segment is grown one stop at a time as j advances.
+template <typename TravelTime>
+vector<int> twoOptTimed(const Graph& graph, const vector<int>& route, TravelTime& travelTime) {
+
+    int n = route.size();
+    if (n <= 3) return route;
+
+    vector<int> bestRoute = route;
+    RouteSchedule schedule(graph, bestRoute, travelTime);
+    bool improved = true;
+
+    while (improved) {
+        improved = false;
+
+        for (int i = 1; i < n - 2; i++) {
+            TimeSegment reversed = segmentOf(graph, bestRoute[i]);
+
+            for (int j = i + 1; j < n - 1; j++) {
+
+                // stops j, j - 1, ..., i; graph edges are undirected so the leg times are shared
+                reversed = concat(segmentOf(graph, bestRoute[j]), reversed, schedule.legAt(j - 1));
+
+                int A = bestRoute[i - 1];
+                int B = bestRoute[i];
+                int C = bestRoute[j];
+                int D = bestRoute[j + 1];
+
+                double before = cost(graph,A, B) + cost(graph,C, D);
+                double after  = cost(graph,A, C) + cost(graph,B, D);
+
+                if (before < 0 || after < 0) continue;
+                if (!(after < before)) continue;
+
+                TimeSegment s = concat(schedule.prefixAt(i - 1), reversed, travelTime(A, C));
+                if (!s.feasible()) continue;
+                if (!concat(s, schedule.suffixAt(j + 1), travelTime(B, D)).feasible()) continue;
+
+                reverse(bestRoute.begin() + i, bestRoute.begin() + j + 1);
+                schedule.rebuild(graph, bestRoute, travelTime);
+                improved = true;
+                break;
+            }
+            if (improved) break;
+        }
+    }
+
+    return bestRoute;
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include <vector>
 #include <unordered_map>
 #include <string>
+#include <limits>
 
 using namespace std;
 
@@ -11,8 +12,17 @@ struct Node {
     int id;
     int demand;
     int priority;
-    Node() : id(0), demand(0), priority(0) {}
-    Node(int id, int demand, int priority) : id(id), demand(demand), priority(priority) {}
+    double readyTime;   // earliest service start
+    double dueTime;     // latest service start, infinity when there is no window
+    double serviceTime; // time spent at the node
+    Node() : id(0), demand(0), priority(0), readyTime(0.0), dueTime(numeric_limits<double>::infinity()), serviceTime(0.0) {}
+    Node(int id, int demand, int priority) : id(id), demand(demand), priority(priority), readyTime(0.0), dueTime(numeric_limits<double>::infinity()), serviceTime(0.0) {}
+    Node(int id, int demand, int priority, double readyTime, double dueTime, double serviceTime)
+        : id(id), demand(demand), priority(priority), readyTime(readyTime), dueTime(dueTime), serviceTime(serviceTime) {}
+
+    bool hasTimeWindow() const {
+        return readyTime > 0.0 || dueTime != numeric_limits<double>::infinity() || serviceTime > 0.0;
+    }
 };
 
 struct Edge {
@@ -0,0 +1,49 @@
+#include "Graph.h"
+#include "Graph_Generator.h"
+#include "File_Handling.h"
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Writes one synthetic scenario (graph + fleet).
+// A .json output path uses the datasets/*.json layout, anything else the
+// binary scenario format read by loadScenarioFromBinary.
+//
+// usage: graph_generator <output> [generator options]
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "usage: graph_generator <output.json|output.bin> [options]\n" << GENERATOR_FLAGS_HELP;
+        return 1;
+    }
+
+    string output = argv[1];
+    GeneratorConfig config;
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (!applyGeneratorFlag(config, argv[i], argv[i + 1])) {
+            cerr << "Unknown option: " << argv[i] << "\n" << GENERATOR_FLAGS_HELP;
+            return 1;
+        }
+    }
+
+    try {
+        Graph graph = generateGraph(config);
+        vector<Vehicle> vehicles = generateVehicles(graph, config);
+
+        bool json = output.size() >= 5 && output.compare(output.size() - 5, 5, ".json") == 0;
+        bool ok = json ? saveScenarioToJSON(output, graph, vehicles)
+                       : saveScenarioToBinary(output, graph, vehicles);
+
+        if (!ok) return 1;
+
+        cout << "Wrote " << output << ": " << graph.numNodes() << " nodes, "
+             << graph.numEdges() << " edges, " << vehicles.size() << " vehicles" << endl;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
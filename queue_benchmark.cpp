@@ -0,0 +1,169 @@
+#include <chrono>
+#include "Graph.h"
+#include "Astar_Algorithm.h"
+#include "Greedy_Allocation.h"
+#include "Multi_Objective_Algorithm.h"
+#include "File_Handling.h"
+#include <iostream>
+#include <string>
+#include <iomanip>
+
+using namespace std;
+using namespace std::chrono;
+
+// Microbenchmark for the astar() queue implementations.
+// Replays the full greedy allocation (every A* query it issues) once per
+// queue type and reports wall time plus the resulting combined score, so a
+// queue that changes routes shows up next to one that is just faster.
+//
+// The allocation time is dominated by the per call map setup in astar(), so
+// a second table times the queues alone: every push / pop the allocation's
+// A* queries make is recorded once (on the binary heap) and the same
+// sequence is replayed against each queue type.
+//
+// usage: queue_benchmark [dataset.json ...]
+
+// one recorded queue operation; node is OP_POP for a pop and OP_NEW_QUERY
+// where a new A* query (and so a fresh queue) starts
+struct QueueOp {
+    int node;
+    double key;
+};
+
+const int OP_POP = -1;
+const int OP_NEW_QUERY = -2;
+
+// binary heap that logs every push and pop it serves
+class RecordingQueue {
+private:
+    BinaryHeapQueue inner;
+    vector<QueueOp>& trace;
+
+public:
+    explicit RecordingQueue(vector<QueueOp>& trace) : trace(trace) {}
+
+    void push(int node, double key) {
+        trace.push_back({node, key});
+        inner.push(node, key);
+    }
+
+    int pop() {
+        trace.push_back({OP_POP, 0.0});
+        return inner.pop();
+    }
+
+    bool empty() const { return inner.empty(); }
+};
+
+// Replays a trace, constructing a fresh queue per query like astar() does.
+// The 4-ary heap merges duplicate pushes, so it can run dry before the
+// recorded pops do; those pops are skipped. Returns nanoseconds.
+template <typename Queue>
+double replayTrace(const vector<QueueOp>& trace, long long& checksum) {
+    auto start = high_resolution_clock::now();
+
+    Queue pq;
+    for (const QueueOp& op : trace) {
+        if (op.node == OP_NEW_QUERY) {
+            pq = Queue();
+        } else if (op.node == OP_POP) {
+            if (!pq.empty()) checksum += pq.pop();
+        } else {
+            pq.push(op.node, op.key);
+        }
+    }
+
+    auto end = high_resolution_clock::now();
+    return duration_cast<nanoseconds>(end - start).count();
+}
+
+double replayTrace(QueueType type, const vector<QueueOp>& trace, long long& checksum) {
+    switch (type) {
+        case QueueType::RADIX_HEAP:   return replayTrace<RadixHeapQueue>(trace, checksum);
+        case QueueType::DIAL_BUCKETS: return replayTrace<DialQueue>(trace, checksum);
+        case QueueType::QUAD_HEAP:    return replayTrace<QuadHeapQueue>(trace, checksum);
+        default:                      return replayTrace<BinaryHeapQueue>(trace, checksum);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    vector<string> datasetFiles;
+    for (int i = 1; i < argc; i++) datasetFiles.push_back(argv[i]);
+
+    if (datasetFiles.empty()) {
+        datasetFiles = {
+            "datasets/input1.json",
+            "datasets/input2.json",
+            "datasets/input3.json"
+        };
+    }
+
+    const QueueType types[] = {
+        QueueType::BINARY_HEAP,
+        QueueType::RADIX_HEAP,
+        QueueType::DIAL_BUCKETS,
+        QueueType::QUAD_HEAP
+    };
+
+    for (const auto& filename : datasetFiles) {
+        try {
+            Graph graph = loadGraphFromJSON(filename);
+            vector<Vehicle> vehicles = loadVehiclesFromJSON(filename);
+
+            cout << "\n===================================================" << endl;
+            cout << "Dataset: " << filename << " (" << graph.numNodes() << " nodes, "
+                 << graph.numEdges() << " edges, " << vehicles.size() << " vehicles)" << endl;
+            cout << "===================================================" << endl;
+
+            double baselineTime = 0.0;
+
+            for (QueueType type : types) {
+                auto start = high_resolution_clock::now();
+
+                vector<Vehicle> allocated = allocateVehicles(graph, vehicles, type);
+
+                auto end = high_resolution_clock::now();
+                double time = duration_cast<nanoseconds>(end - start).count();
+
+                if (type == QueueType::BINARY_HEAP) baselineTime = time;
+
+                double totalScore = 0.0;
+                for (const auto& vehicle : allocated) {
+                    totalScore += calculateRouteCost(graph, vehicle.route, vehicle.capacity, vehicle.currentLoad).finalScore;
+                }
+
+                cout << left << setw(14) << queueTypeName(type)
+                     << " allocation: " << fixed << setprecision(2) << time / 1e6 << " ms"
+                     << "  speedup: " << setprecision(2) << (time > 0 ? baselineTime / time : 0.0) << "x"
+                     << "  combined score: " << totalScore << endl;
+            }
+
+            vector<QueueOp> trace;
+            allocateVehiclesWith(graph, vehicles, [&](int from, int to) {
+                trace.push_back({OP_NEW_QUERY, 0.0});
+                RecordingQueue pq(trace);
+                return pathCost(graph, astarWithQueue(graph, from, to, pq));
+            }, "A* (recording)");
+
+            cout << "\nQueue only, " << trace.size() << " recorded operations:" << endl;
+
+            double baselineReplay = 0.0;
+            long long checksum = 0;
+
+            for (QueueType type : types) {
+                double time = replayTrace(type, trace, checksum);
+                if (type == QueueType::BINARY_HEAP) baselineReplay = time;
+
+                cout << left << setw(14) << queueTypeName(type)
+                     << " replay: " << fixed << setprecision(2) << time / 1e6 << " ms"
+                     << "  speedup: " << setprecision(2) << (time > 0 ? baselineReplay / time : 0.0) << "x"
+                     << "  ns/op: " << setprecision(1) << (trace.empty() ? 0.0 : time / trace.size()) << endl;
+            }
+            if (checksum == 42) cout << endl; // keeps the replays from being optimised away
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+        }
+    }
+
+    return 0;
+}
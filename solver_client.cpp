@@ -0,0 +1,72 @@
+#include <iostream>
+#include <string>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace std;
+
+// Stand-in client for solver_service --socket. Sends every line of stdin as
+// one request, then prints the responses as they arrive (in completion
+// order, match them up by "scenario").
+//
+// usage: solver_client <socket path> < requests.ndjson
+//
+// datasets/solver_requests.ndjson is a request set for datasets/input1.json
+// covering every mode, the error replies, and requests whose vehicles carry
+// "id" / "mode" keys of their own; each reply's "scenario" must equal the id
+// of the request it answers.
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "usage: solver_client <socket path> < requests.ndjson" << endl;
+        return 1;
+    }
+
+#ifdef _WIN32
+    cerr << "Socket mode is not available on this platform" << endl;
+    return 1;
+#else
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, argv[1], sizeof(address.sun_path) - 1);
+
+    if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cerr << "Cannot connect to " << argv[1] << endl;
+        return 1;
+    }
+
+    string line;
+    while (getline(cin, line)) {
+        line += '\n';
+        size_t sent = 0;
+        while (sent < line.size()) {
+            ssize_t n = write(fd, line.data() + sent, line.size() - sent);
+            if (n <= 0) {
+                cerr << "Connection closed by server" << endl;
+                close(fd);
+                return 1;
+            }
+            sent += n;
+        }
+    }
+
+    // no more requests; the server closes its side after the last response
+    shutdown(fd, SHUT_WR);
+
+    char chunk[4096];
+    ssize_t n;
+    while ((n = read(fd, chunk, sizeof(chunk))) > 0) fwrite(chunk, 1, n, stdout);
+
+    close(fd);
+    return 0;
+#endif
+}
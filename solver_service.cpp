@@ -0,0 +1,233 @@
+#include "Graph.h"
+#include "Greedy_Allocation.h"
+#include "Contraction_Hierarchy.h"
+#include "File_Handling.h"
+#include "Solver_Service.h"
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <list>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <csignal>
+#include <cstring>
+#endif
+
+using namespace std;
+
+// Solver daemon. Loads a scenario once (datasets/*.json or a binary scenario),
+// loads or builds its contraction hierarchy next to it, then serves NDJSON
+// solve requests (see Solver_Service.h) until stdin closes or, in socket
+// mode, until a {"command": "shutdown"} line arrives.
+//
+// usage: solver_service <dataset> [--socket PATH] [--workers N] [--batch N]
+
+#ifndef _WIN32
+
+// one client connection; the socket is closed once the reader and every
+// pending reply have let go of it
+struct Connection {
+    int fd;
+    mutex writeMutex;
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { close(fd); }
+
+    void send(const string& data) {
+        lock_guard<mutex> lock(writeMutex);
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = write(fd, data.data() + sent, data.size() - sent);
+            if (n <= 0) return; // client went away
+            sent += n;
+        }
+    }
+};
+
+int serveSocket(SolverService& service, const string& path) {
+    signal(SIGPIPE, SIG_IGN);
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        cerr << "Cannot create socket" << endl;
+        return 1;
+    }
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    unlink(path.c_str());
+
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 16) < 0) {
+        cerr << "Cannot listen on " << path << endl;
+        close(listener);
+        return 1;
+    }
+
+    cerr << "Listening on " << path << endl;
+
+    struct Reader {
+        thread worker;
+        shared_ptr<atomic<bool>> done;
+    };
+
+    atomic<bool> running(true);
+    list<Reader> readers;
+    mutex openMutex;
+    vector<weak_ptr<Connection>> open;
+
+    while (running) {
+        int fd = accept(listener, nullptr, nullptr);
+        if (fd < 0) break; // listener shut down
+
+        // join readers of clients that have gone, so a long running daemon
+        // does not keep one thread and one entry per past connection
+        for (auto it = readers.begin(); it != readers.end();) {
+            if (!*it->done) {
+                ++it;
+                continue;
+            }
+            it->worker.join();
+            it = readers.erase(it);
+        }
+
+        auto connection = make_shared<Connection>(fd);
+        {
+            lock_guard<mutex> lock(openMutex);
+            open.erase(remove_if(open.begin(), open.end(), [](const weak_ptr<Connection>& c) { return c.expired(); }), open.end());
+            open.push_back(connection);
+        }
+
+        auto done = make_shared<atomic<bool>>(false);
+        thread worker([&, listener, connection, done]() {
+            string buffer;
+            char chunk[4096];
+
+            while (true) {
+                ssize_t n = read(connection->fd, chunk, sizeof(chunk));
+                if (n <= 0) break;
+                buffer.append(chunk, n);
+
+                size_t newline;
+                while ((newline = buffer.find('\n')) != string::npos) {
+                    string line = buffer.substr(0, newline);
+                    buffer.erase(0, newline + 1);
+                    if (line.find_first_not_of(" \t\r") == string::npos) continue;
+
+                    if (extractJsonString(line, "command") == "shutdown") {
+                        running = false;
+                        shutdown(listener, SHUT_RDWR); // wakes up accept()
+
+                        // stop reading from idle clients too; queued replies still go out
+                        lock_guard<mutex> lock(openMutex);
+                        for (auto& other : open) {
+                            if (auto live = other.lock()) shutdown(live->fd, SHUT_RD);
+                        }
+                        continue;
+                    }
+
+                    service.submit(line, [connection](const string& response) {
+                        connection->send(response);
+                    });
+                }
+            }
+            *done = true;
+        });
+        readers.push_back({move(worker), done});
+    }
+
+    for (auto& reader : readers) reader.worker.join();
+    close(listener);
+    unlink(path.c_str());
+    return 0;
+}
+
+#endif
+
+int serveStdin(SolverService& service) {
+    mutex outMutex;
+    string line;
+
+    while (getline(cin, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) continue;
+
+        service.submit(line, [&outMutex](const string& response) {
+            lock_guard<mutex> lock(outMutex);
+            fwrite(response.data(), 1, response.size(), stdout);
+            fflush(stdout);
+        });
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "usage: solver_service <dataset> [--socket PATH] [--workers N] [--batch N]" << endl;
+        return 1;
+    }
+
+    string dataset = argv[1];
+    string socketPath;
+    int workers = 0;
+    int batch = 8;
+
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--socket") socketPath = argv[i + 1];
+        else if (flag == "--workers") workers = stoi(argv[i + 1]);
+        else if (flag == "--batch") batch = stoi(argv[i + 1]);
+        else {
+            cerr << "Unknown option: " << flag << endl;
+            return 1;
+        }
+    }
+
+    // stdout carries responses, so library progress output goes to stderr
+    cout.rdbuf(cerr.rdbuf());
+
+    try {
+        Graph graph;
+        vector<Vehicle> vehicles;
+
+        bool json = dataset.size() >= 5 && dataset.compare(dataset.size() - 5, 5, ".json") == 0;
+        if (json) {
+            graph = loadGraphFromJSON(dataset);
+        } else {
+            loadScenarioFromBinary(dataset, graph, vehicles);
+        }
+
+        cerr << "Graph loaded: " << graph.numNodes() << " nodes, " << graph.numEdges() << " edges" << endl;
+
+        ContractionHierarchy ch = loadOrBuildHierarchy(graph, hierarchyPathFor(dataset));
+        cerr << "Hierarchy ready: " << ch.numShortcuts() << " shortcuts" << endl;
+
+        SolverService service(graph, ch, workers, batch);
+
+        int status;
+        if (!socketPath.empty()) {
+#ifndef _WIN32
+            status = serveSocket(service, socketPath);
+#else
+            cerr << "Socket mode is not available on this platform" << endl;
+            status = 1;
+#endif
+        } else {
+            status = serveStdin(service);
+        }
+
+        service.shutdown();
+        return status;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,352 @@
+#include <chrono>
+#include "Graph.h"
+#include "Greedy_Allocation.h"
+#include "Multi_Objective_Algorithm.h"
+#include "Two_Opt_Algorithm.h"
+#include "Graph_Generator.h"
+#include "File_Handling.h"
+#include "Contraction_Hierarchy.h"
+#include "Cluster_Allocation.h"
+#include "Tail_Distances.h"
+#include "Result_Writer.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <sstream>
+#include <iomanip>
+#include <functional>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <memory>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif !defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+// Stress harness: generates synthetic scenarios of doubling size and runs
+// every stage of the pipeline (generate, JSON and binary round trip,
+// allocate -> twoOpt -> score, allocation on memoized tail trees, contraction
+// hierarchy build, and greedy and clustered allocation on top of it),
+// recording wall time and peak memory per stage. Once a stage is predicted
+// to exceed the time budget it is skipped for all larger sizes (together
+// with the stages that need its output), so the table shows where each
+// stage stops scaling. twoOpt and score fall back to the memoized routes once
+// A* allocation is skipped; the table and CSV say which routes they used.
+//
+// With --results every allocation is streamed into one file through a result
+// sink (.bin for the binary format, NDJSON otherwise). A binary file is read
+// back at the end and checked record by record against what was written.
+//
+// usage: stress_harness [--min-nodes N] [--max-nodes N] [--budget SECONDS]
+//                       [--csv results.csv] [--results FILE] [--tmp DIR]
+//                       [generator options]
+
+#pragma region Memory
+
+// Starts a new peak measurement window where the platform allows it.
+void resetPeakMemory() {
+#if defined(__linux__)
+    ofstream clear("/proc/self/clear_refs");
+    if (clear.is_open()) clear << "5";
+#endif
+}
+
+// Peak resident memory in MB since the last resetPeakMemory(); on platforms
+// without a resettable counter this is the peak for the whole process.
+double peakMemoryMB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0.0;
+#elif defined(__linux__)
+    ifstream status("/proc/self/status");
+    string line;
+    while (getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return stod(line.substr(6)) / 1024.0;
+    }
+    return 0.0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+#endif
+}
+
+#pragma endregion
+
+struct StageResult {
+    string stage;
+    bool ran = false;
+    double seconds = 0.0;
+    double peakMB = 0.0;
+    string note;
+    string input;   // allocation a stage worked on, when it has a choice
+};
+
+struct StageHistory {
+    int lastNodes = 0;
+    double lastSeconds = 0.0;
+    double exponent = 2.0; // assumed growth until we have two points
+    bool disabled = false;
+};
+
+int main(int argc, char* argv[]) {
+    GeneratorConfig config;
+    int minNodes = 1000;
+    int maxNodes = 1 << 20;
+    double budget = 60.0;
+    string csvPath;
+    string resultsPath;
+    string tmpDir = ".";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string flag = argv[i];
+        string value = argv[i + 1];
+
+        if (flag == "--min-nodes") minNodes = stoi(value);
+        else if (flag == "--max-nodes") maxNodes = stoi(value);
+        else if (flag == "--budget") budget = stod(value);
+        else if (flag == "--csv") csvPath = value;
+        else if (flag == "--results") resultsPath = value;
+        else if (flag == "--tmp") tmpDir = value;
+        else if (!applyGeneratorFlag(config, flag, value)) {
+            cerr << "Unknown option: " << flag << "\n"
+                 << "  --min-nodes N   --max-nodes N   --budget SECONDS   --csv FILE   --results FILE   --tmp DIR\n"
+                 << GENERATOR_FLAGS_HELP;
+            return 1;
+        }
+    }
+
+    ofstream csv;
+    if (!csvPath.empty()) {
+        csv.open(csvPath);
+        csv << "nodes,edges,vehicles,stage,status,seconds,peak_mb,input\n";
+    }
+
+    unique_ptr<ResultSink> sink;
+    bool binaryResults = resultsPath.size() >= 4 && resultsPath.compare(resultsPath.size() - 4, 4, ".bin") == 0;
+    vector<ResultRecord> written; // kept to verify the binary round trip
+    bool resultsOk = true;
+    if (!resultsPath.empty()) {
+        if (binaryResults) sink.reset(new BinaryResultSink(resultsPath));
+        else sink.reset(new NdjsonResultSink(resultsPath));
+    }
+
+    map<string, StageHistory> history;
+    string jsonPath = tmpDir + "/stress_scenario.json";
+    string binPath = tmpDir + "/stress_scenario.bin";
+
+    cout << "===================================================" << endl;
+    cout << "Stress Harness (budget " << budget << " s per stage)" << endl;
+    cout << "===================================================" << endl;
+
+    for (int nodes = minNodes; nodes <= maxNodes; nodes *= 2) {
+        config.numNodes = nodes;
+
+        Graph graph;
+        vector<Vehicle> vehicles;
+        vector<StageResult> results;
+        vector<pair<string, vector<Vehicle>>> produced; // allocations for the result sink
+
+        // runs one stage unless it was disabled or is predicted to blow the budget
+        auto runStage = [&](const string& name, bool inputReady, const function<void()>& body) {
+            StageResult result;
+            result.stage = name;
+            StageHistory& h = history[name];
+
+            if (!inputReady) {
+                result.note = "skipped (no input)";
+            } else if (h.disabled) {
+                result.note = "skipped (over budget)";
+            } else {
+                double predicted = 0.0;
+                if (h.lastNodes > 0) predicted = h.lastSeconds * pow((double)nodes / h.lastNodes, h.exponent);
+
+                if (predicted > budget) {
+                    h.disabled = true;
+                    ostringstream note;
+                    note << "skipped (predicted " << fixed << setprecision(0) << predicted << " s)";
+                    result.note = note.str();
+                } else {
+                    resetPeakMemory();
+                    auto start = high_resolution_clock::now();
+                    body();
+                    auto end = high_resolution_clock::now();
+
+                    result.ran = true;
+                    result.seconds = duration_cast<nanoseconds>(end - start).count() / 1e9;
+                    result.peakMB = peakMemoryMB();
+
+                    // fit the growth exponent once timings are large enough to mean something
+                    if (h.lastNodes > 0 && h.lastSeconds > 1e-3 && result.seconds > 1e-3) {
+                        h.exponent = max(1.0, log(result.seconds / h.lastSeconds) / log((double)nodes / h.lastNodes));
+                    }
+                    h.lastNodes = nodes;
+                    h.lastSeconds = result.seconds;
+                    if (result.seconds > budget) h.disabled = true;
+                }
+            }
+            results.push_back(result);
+            return result.ran;
+        };
+
+        bool generated = runStage("generate", true, [&]() {
+            graph = generateGraph(config);
+            vehicles = generateVehicles(graph, config);
+        });
+
+        if (!generated) {
+            cout << "\nStopping: generation no longer fits the budget." << endl;
+            break;
+        }
+
+        int numEdges = graph.numEdges();
+        int numVehicles = vehicles.size();
+
+        runStage("write-json", true, [&]() { saveScenarioToJSON(jsonPath, graph, vehicles); });
+        bool jsonWritten = results.back().ran;
+        runStage("load-json", jsonWritten, [&]() {
+            Graph loaded = loadGraphFromJSON(jsonPath);
+            vector<Vehicle> loadedVehicles = loadVehiclesFromJSON(jsonPath);
+        });
+
+        runStage("write-bin", true, [&]() { saveScenarioToBinary(binPath, graph, vehicles); });
+        bool binWritten = results.back().ran;
+        runStage("load-bin", binWritten, [&]() {
+            Graph loaded;
+            vector<Vehicle> loadedVehicles;
+            loadScenarioFromBinary(binPath, loaded, loadedVehicles);
+        });
+
+        vector<Vehicle> allocated;
+        bool allocatedOk = runStage("allocate", true, [&]() {
+            allocated = allocateVehicles(graph, vehicles);
+        });
+
+        vector<Vehicle> allocatedMemo;
+        bool memoOk = runStage("alloc-memo", true, [&]() { allocatedMemo = allocateVehiclesMemoized(graph, vehicles); });
+        if (memoOk) produced.push_back({"alloc-memo", allocatedMemo});
+
+        // twoOpt and score run on the A* routes while A* fits the budget and
+        // on the memoized routes after that, so they keep scaling past A*
+        string routesFrom = allocatedOk ? "allocate" : "alloc-memo";
+        vector<Vehicle> optimized = allocatedOk ? allocated : allocatedMemo;
+
+        bool optimizedOk = runStage("two-opt", allocatedOk || memoOk, [&]() {
+            for (auto& vehicle : optimized) vehicle.route = twoOpt(graph, vehicle.route);
+        });
+        results.back().input = routesFrom;
+
+        double totalScore = 0.0;
+        runStage("score", optimizedOk, [&]() {
+            for (const auto& vehicle : optimized) {
+                totalScore += calculateRouteCost(graph, vehicle.route, vehicle.capacity, vehicle.currentLoad).finalScore;
+            }
+        });
+        results.back().input = routesFrom;
+        if (optimizedOk) produced.push_back({routesFrom + "-two-opt", optimized});
+
+        ContractionHierarchy ch;
+        bool chBuilt = runStage("ch-build", true, [&]() { ch.build(graph); });
+        vector<Vehicle> allocatedCH;
+        if (runStage("allocate-ch", chBuilt, [&]() { allocatedCH = allocateVehicles(graph, vehicles, ch); })) {
+            produced.push_back({"allocate-ch", allocatedCH});
+        }
+
+        ClusterOptions clusterOptions;
+        clusterOptions.method = ClusterMethod::K_MEDOIDS;
+        vector<Vehicle> clustered;
+        if (runStage("cluster-ch", chBuilt, [&]() { clustered = allocateVehiclesClustered(graph, vehicles, ch, clusterOptions); })) {
+            produced.push_back({"cluster-ch", clustered});
+        }
+
+        if (sink) {
+            runStage("results", !produced.empty(), [&]() {
+                for (const auto& entry : produced) {
+                    ResultRecord record;
+                    record.scenario = "n" + to_string(nodes) + "-" + entry.first;
+                    record.vehicles = entry.second;
+                    for (const auto& vehicle : record.vehicles) {
+                        record.costs.push_back(calculateRouteCost(graph, vehicle.route, vehicle.capacity, vehicle.currentLoad));
+                    }
+                    if (!sink->write(record.scenario, record.vehicles, record.costs)) resultsOk = false;
+                    if (binaryResults) written.push_back(move(record));
+                }
+            });
+        }
+
+        cout << "\nNodes: " << nodes << "  Edges: " << numEdges << "  Vehicles: " << numVehicles << endl;
+        for (const auto& r : results) {
+            cout << "  " << left << setw(11) << r.stage << right;
+            if (r.ran) {
+                cout << fixed << setprecision(3) << setw(10) << r.seconds << " s"
+                     << setprecision(1) << setw(10) << r.peakMB << " MB peak";
+                if (!r.input.empty()) cout << "  (on " << r.input << ")";
+                cout << endl;
+            } else {
+                cout << "  " << r.note << endl;
+            }
+
+            if (csv.is_open()) {
+                csv << nodes << "," << numEdges << "," << numVehicles << "," << r.stage << ","
+                    << (r.ran ? "ok" : "skipped") << "," << r.seconds << "," << r.peakMB << "," << r.input << "\n";
+            }
+        }
+        if (optimizedOk) cout << "  combined score: " << fixed << setprecision(2) << totalScore << " (" << routesFrom << " routes)" << endl;
+        if (csv.is_open()) csv.flush();
+    }
+
+    remove(jsonPath.c_str());
+    remove(binPath.c_str());
+
+    if (sink) {
+        if (!sink->flush()) resultsOk = false;
+        sink.reset();
+
+        if (!resultsOk) {
+            cerr << "\nFailed to write results to " << resultsPath << endl;
+            return 1;
+        }
+        cout << "\nResults written to " << resultsPath << endl;
+    }
+
+    if (binaryResults) {
+        vector<ResultRecord> loaded = loadResultsFromBinary(resultsPath);
+        bool same = loaded.size() == written.size();
+
+        for (size_t r = 0; same && r < loaded.size(); r++) {
+            const ResultRecord& a = loaded[r];
+            const ResultRecord& b = written[r];
+            same = a.scenario == b.scenario && a.vehicles.size() == b.vehicles.size();
+
+            for (size_t i = 0; same && i < a.vehicles.size(); i++) {
+                same = a.vehicles[i].id == b.vehicles[i].id
+                    && a.vehicles[i].capacity == b.vehicles[i].capacity
+                    && a.vehicles[i].currentLoad == b.vehicles[i].currentLoad
+                    && a.vehicles[i].route == b.vehicles[i].route
+                    && a.costs[i].totalTime == b.costs[i].totalTime
+                    && a.costs[i].reliabilityPenalty == b.costs[i].reliabilityPenalty
+                    && a.costs[i].idleTime == b.costs[i].idleTime
+                    && a.costs[i].finalScore == b.costs[i].finalScore;
+            }
+        }
+
+        cout << "Binary round trip: " << loaded.size() << " records " << (same ? "match" : "DO NOT match") << endl;
+        if (!same) return 1;
+    }
+
+    return 0;
+}